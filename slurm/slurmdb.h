@@ -616,6 +616,9 @@ struct slurmdb_assoc_usage {
 	bitstr_t *valid_qos;    /* qos available for this association
 				 * derived from the qos_list.
 				 * (DON'T PACK for state file) */
+	bitstr_t *limited_tres; /* tres with any limit set for this
+				 * association, derived from the tres
+				 * limits (DON'T PACK for state file) */
 };
 
 typedef struct {
@@ -840,6 +843,9 @@ typedef struct {
 					 * (DON'T PACK for state file) */
 	double grp_used_wall;   /* group count of time (minutes) used in
 				 * running jobs */
+	bitstr_t *limited_tres; /* tres with any limit set for this qos,
+				 * derived from the tres limits
+				 * (DON'T PACK for state file) */
 	double norm_priority;/* normalized priority (DON'T PACK for
 			      * state file) */
 	uint32_t tres_cnt; /* size of the tres arrays,
@@ -1005,7 +1005,7 @@ static inline bool _test_local_job(uint32_t job_id)
 
 static int
 _load_cluster_jobs(slurm_msg_t *req_msg, job_info_msg_t **job_info_msg_pptr,
-		   slurmdb_cluster_rec_t *cluster)
+		   slurmdb_cluster_rec_t *cluster, uint16_t show_flags)
 {
 	slurm_msg_t resp_msg;
 	int rc = SLURM_SUCCESS;
@@ -1014,11 +1014,16 @@ _load_cluster_jobs(slurm_msg_t *req_msg, job_info_msg_t **job_info_msg_pptr,
 
 	*job_info_msg_pptr = NULL;
 
+	/* Let the records' strings point into the response, not copies */
+	if (show_flags & SHOW_NO_COPY)
+		req_msg->flags |= SLURM_MSG_BORROW_BUFFER;
+
 	if (slurm_send_recv_controller_msg(req_msg, &resp_msg, cluster) < 0)
 		return SLURM_ERROR;
 
 	switch (resp_msg.msg_type) {
 	case RESPONSE_JOB_INFO:
+	case RESPONSE_JOB_INFO_DELTA:
 		*job_info_msg_pptr = (job_info_msg_t *)resp_msg.data;
 		resp_msg.data = NULL;
 		break;
@@ -1044,7 +1049,8 @@ static void *_load_job_thread(void *args)
 	job_info_msg_t *new_msg = NULL;
 	int rc;
 
-	if ((rc = _load_cluster_jobs(load_args->req_msg, &new_msg, cluster)) ||
+	if ((rc = _load_cluster_jobs(load_args->req_msg, &new_msg, cluster,
+				     0)) ||
 	    !new_msg) {
 		verbose("Error reading job information from cluster %s: %s",
 			cluster->name, slurm_strerror(rc));
@@ -1283,7 +1289,7 @@ slurm_load_jobs (time_t update_time, job_info_msg_t **job_info_msg_pptr,
 	    cluster_in_federation(ptr, cluster_name)) {
 		/* In federation. Need full info from all clusters */
 		update_time = (time_t) 0;
-		show_flags &= (~SHOW_LOCAL);
+		show_flags &= (~(SHOW_LOCAL | SHOW_DELTA));
 	} else {
 		/* Report local cluster info only */
 		show_flags |= SHOW_LOCAL;
@@ -1292,7 +1298,7 @@ slurm_load_jobs (time_t update_time, job_info_msg_t **job_info_msg_pptr,
 
 	slurm_msg_t_init(&req_msg);
 	req.last_update  = update_time;
-	req.show_flags   = show_flags;
+	req.show_flags   = show_flags & (~SHOW_NO_COPY);
 	req_msg.msg_type = REQUEST_JOB_INFO;
 	req_msg.data     = &req;
 
@@ -1302,7 +1308,7 @@ slurm_load_jobs (time_t update_time, job_info_msg_t **job_info_msg_pptr,
 				    cluster_name, fed);
 	} else {
 		rc = _load_cluster_jobs(&req_msg, job_info_msg_pptr,
-					working_cluster_rec);
+					working_cluster_rec, show_flags);
 	}
 
 	if (ptr)
@@ -1312,6 +1318,104 @@ slurm_load_jobs (time_t update_time, job_info_msg_t **job_info_msg_pptr,
 	return rc;
 }
 
+static int _cmp_job_id(const void *x, const void *y)
+{
+	uint32_t job_id_x = *(uint32_t *) x;
+	uint32_t job_id_y = *(uint32_t *) y;
+
+	if (job_id_x < job_id_y)
+		return -1;
+	if (job_id_x > job_id_y)
+		return 1;
+	return 0;
+}
+
+/*
+ * Apply a job information delta to previously loaded job information,
+ * replacing changed records and dropping removed ones. The delta's records
+ * are moved into job_info_msg and delta_msg is freed.
+ */
+static void _merge_job_info_delta(job_info_msg_t *job_info_msg,
+				  job_info_msg_t *delta_msg)
+{
+	slurm_job_info_t *job_array;
+	uint32_t *drop_ids, drop_cnt, i, new_cnt = 0;
+
+	/* IDs of records to drop, sorted for bsearch() */
+	drop_cnt = delta_msg->record_count + delta_msg->removed_cnt;
+	drop_ids = xmalloc(sizeof(uint32_t) * (drop_cnt + 1));
+	for (i = 0; i < delta_msg->record_count; i++)
+		drop_ids[i] = delta_msg->job_array[i].job_id;
+	for (i = 0; i < delta_msg->removed_cnt; i++)
+		drop_ids[delta_msg->record_count + i] =
+			delta_msg->removed_job_ids[i];
+	qsort(drop_ids, drop_cnt, sizeof(uint32_t), _cmp_job_id);
+
+	job_array = xmalloc(sizeof(slurm_job_info_t) *
+			    (job_info_msg->record_count +
+			     delta_msg->record_count + 1));
+	for (i = 0; i < job_info_msg->record_count; i++) {
+		slurm_job_info_t *job_ptr = &job_info_msg->job_array[i];
+		if (bsearch(&job_ptr->job_id, drop_ids, drop_cnt,
+			    sizeof(uint32_t), _cmp_job_id))
+			slurm_free_job_info_members(job_ptr);
+		else
+			job_array[new_cnt++] = *job_ptr;
+	}
+	for (i = 0; i < delta_msg->record_count; i++)
+		job_array[new_cnt++] = delta_msg->job_array[i];
+	xfree(drop_ids);
+
+	xfree(job_info_msg->job_array);
+	job_info_msg->job_array = job_array;
+	job_info_msg->record_count = new_cnt;
+	job_info_msg->last_update = delta_msg->last_update;
+
+	/* The delta's records now belong to job_info_msg */
+	xfree(delta_msg->job_array);
+	delta_msg->record_count = 0;
+	slurm_free_job_info_msg(delta_msg);
+}
+
+/*
+ * slurm_load_jobs_delta - update a local copy of all job information,
+ *	transferring only the records changed since it was last loaded
+ * IN/OUT job_info_msg_pptr - job information previously loaded by this
+ *	function, updated in place (or NULL to load all job information)
+ * IN show_flags - job filtering options, must not change between calls
+ * RET 0 or -1 on error
+ * NOTE: free the response using slurm_free_job_info_msg
+ */
+extern int slurm_load_jobs_delta(job_info_msg_t **job_info_msg_pptr,
+				 uint16_t show_flags)
+{
+	job_info_msg_t *old_msg = *job_info_msg_pptr, *new_msg = NULL;
+	time_t update_time = (time_t) 0;
+	int rc;
+
+	if (old_msg)
+		update_time = old_msg->last_update;
+
+	/* Records are moved between messages, so they must own their strings */
+	show_flags &= (~SHOW_NO_COPY);
+	rc = slurm_load_jobs(update_time, &new_msg, show_flags | SHOW_DELTA);
+	if (rc != SLURM_SUCCESS) {
+		if (old_msg && (slurm_get_errno() == SLURM_NO_CHANGE_IN_DATA))
+			return SLURM_SUCCESS;
+		return rc;
+	}
+
+	if (!new_msg->delta || !old_msg) {
+		slurm_free_job_info_msg(old_msg);
+		new_msg->delta = 0;
+		*job_info_msg_pptr = new_msg;
+	} else {
+		_merge_job_info_delta(old_msg, new_msg);
+	}
+
+	return SLURM_SUCCESS;
+}
+
 /*
  * slurm_load_job_user - issue RPC to get slurm information about all jobs
  *	to be run as the specified user
@@ -1342,7 +1446,7 @@ extern int slurm_load_job_user (job_info_msg_t **job_info_msg_pptr,
 	}
 
 	slurm_msg_t_init(&req_msg);
-	req.show_flags   = show_flags;
+	req.show_flags   = show_flags & (~SHOW_NO_COPY);
 	req.user_id      = user_id;
 	req_msg.msg_type = REQUEST_JOB_USER_INFO;
 	req_msg.data     = &req;
@@ -1351,7 +1455,7 @@ extern int slurm_load_job_user (job_info_msg_t **job_info_msg_pptr,
 	 * information for that cluster */
 	if (working_cluster_rec || !ptr || (show_flags & SHOW_LOCAL)) {
 		rc = _load_cluster_jobs(&req_msg, job_info_msg_pptr,
-					working_cluster_rec);
+					working_cluster_rec, show_flags);
 	} else {
 		fed = (slurmdb_federation_rec_t *) ptr;
 		rc = _load_fed_jobs(&req_msg, job_info_msg_pptr, show_flags,
@@ -1396,7 +1500,7 @@ slurm_load_job (job_info_msg_t **job_info_msg_pptr, uint32_t job_id,
 	memset(&req, 0, sizeof(job_id_msg_t));
 	slurm_msg_t_init(&req_msg);
 	req.job_id       = job_id;
-	req.show_flags   = show_flags;
+	req.show_flags   = show_flags & (~SHOW_NO_COPY);
 	req_msg.msg_type = REQUEST_JOB_INFO_SINGLE;
 	req_msg.data     = &req;
 
@@ -1404,7 +1508,7 @@ slurm_load_job (job_info_msg_t **job_info_msg_pptr, uint32_t job_id,
 	 * information for that cluster */
 	if (working_cluster_rec || !ptr || (show_flags & SHOW_LOCAL)) {
 		rc = _load_cluster_jobs(&req_msg, job_info_msg_pptr,
-					working_cluster_rec);
+					working_cluster_rec, show_flags);
 	} else {
 		fed = (slurmdb_federation_rec_t *) ptr;
 		rc = _load_fed_jobs(&req_msg, job_info_msg_pptr, show_flags,
@@ -523,6 +523,7 @@ static int _load_cluster_nodes(slurm_msg_t *req_msg,
 
 	switch (resp_msg.msg_type) {
 	case RESPONSE_NODE_INFO:
+	case RESPONSE_NODE_INFO_DELTA:
 		*node_info_msg_pptr = (node_info_msg_t *) resp_msg.data;
 		if (show_flags & SHOW_MIXED)
 			_set_node_mixed(*node_info_msg_pptr);
@@ -700,7 +701,7 @@ extern int slurm_load_node(time_t update_time, node_info_msg_t **resp,
 	    cluster_in_federation(ptr, cluster_name)) {
 		/* In federation. Need full info from all clusters */
 		update_time = (time_t) 0;
-		show_flags &= (~SHOW_LOCAL);
+		show_flags &= (~(SHOW_LOCAL | SHOW_DELTA));
 	} else {
 		/* Report local cluster info only */
 		show_flags |= SHOW_LOCAL;
@@ -748,6 +749,80 @@ extern int slurm_load_node2(time_t update_time, node_info_msg_t **resp,
 	return _load_cluster_nodes(&req_msg, resp, cluster, show_flags);
 }
 
+/*
+ * Apply a node information delta to previously loaded node information,
+ * replacing the changed records. The delta's records are moved into
+ * node_info_msg and delta_msg is freed.
+ * RET SLURM_SUCCESS or SLURM_ERROR if the delta does not match node_info_msg
+ */
+static int _merge_node_info_delta(node_info_msg_t *node_info_msg,
+				  node_info_msg_t *delta_msg)
+{
+	uint32_t i, inx;
+
+	for (i = 0; i < delta_msg->record_count; i++) {
+		if (delta_msg->node_inx[i] >= node_info_msg->record_count) {
+			slurm_free_node_info_msg(delta_msg);
+			return SLURM_ERROR;
+		}
+	}
+
+	for (i = 0; i < delta_msg->record_count; i++) {
+		inx = delta_msg->node_inx[i];
+		slurm_free_node_info_members(&node_info_msg->node_array[inx]);
+		node_info_msg->node_array[inx] = delta_msg->node_array[i];
+	}
+	node_info_msg->last_update = delta_msg->last_update;
+
+	/* The delta's records now belong to node_info_msg */
+	xfree(delta_msg->node_array);
+	delta_msg->record_count = 0;
+	slurm_free_node_info_msg(delta_msg);
+
+	return SLURM_SUCCESS;
+}
+
+/*
+ * slurm_load_node_delta - update a local copy of all node information,
+ *	transferring only the records changed since it was last loaded
+ * IN/OUT resp - node information previously loaded by this function,
+ *	updated in place (or NULL to load all node information)
+ * IN show_flags - node filtering options, must not change between calls
+ * RET 0 or a slurm error code
+ * NOTE: free the response using slurm_free_node_info_msg
+ */
+extern int slurm_load_node_delta(node_info_msg_t **resp, uint16_t show_flags)
+{
+	node_info_msg_t *old_msg = *resp, *new_msg = NULL;
+	time_t update_time = (time_t) 0;
+	int rc;
+
+	if (old_msg)
+		update_time = old_msg->last_update;
+
+	rc = slurm_load_node(update_time, &new_msg, show_flags | SHOW_DELTA);
+	if (rc != SLURM_SUCCESS) {
+		if (old_msg && (slurm_get_errno() == SLURM_NO_CHANGE_IN_DATA))
+			return SLURM_SUCCESS;
+		return rc;
+	}
+
+	if (!new_msg->delta || !old_msg) {
+		slurm_free_node_info_msg(old_msg);
+		new_msg->delta = 0;
+		*resp = new_msg;
+		return SLURM_SUCCESS;
+	}
+
+	if (_merge_node_info_delta(old_msg, new_msg) == SLURM_SUCCESS)
+		return SLURM_SUCCESS;
+
+	/* Local copy is out of step with the node table, reload all of it */
+	slurm_free_node_info_msg(old_msg);
+	*resp = NULL;
+	return slurm_load_node_delta(resp, show_flags);
+}
+
 /*
  * slurm_load_node_single - issue RPC to get slurm configuration information
  *	for a specific node
@@ -741,6 +741,75 @@ static slurmdb_assoc_rec_t* _find_assoc_parent(
 	return parent;
 }
 
+/* Mark the TRES positions of tres_cnt that have a limit in limited_tres */
+static void _add_limited_tres(bitstr_t *limited_tres, uint64_t *tres_cnt)
+{
+	int i;
+
+	if (!tres_cnt)
+		return;
+	for (i = 0; i < g_tres_count; i++) {
+		if (tres_cnt[i] != INFINITE64)
+			bit_set(limited_tres, i);
+	}
+}
+
+/* Clear (allocating if needed) a usage limited_tres bitmap for g_tres_count */
+static bitstr_t *_reset_limited_tres(bitstr_t **limited_tres)
+{
+	if (*limited_tres && (bit_size(*limited_tres) == g_tres_count)) {
+		bit_clear_all(*limited_tres);
+	} else {
+		FREE_NULL_BITMAP(*limited_tres);
+		*limited_tres = bit_alloc(g_tres_count);
+	}
+
+	return *limited_tres;
+}
+
+/*
+ * Record which TRES have any limit set for an association so acct_policy
+ * only needs to look at those. Call after any of the *_ctld arrays change.
+ */
+static void _set_assoc_limited_tres(slurmdb_assoc_rec_t *assoc)
+{
+	bitstr_t *limited_tres;
+
+	if (!assoc->usage || !g_tres_count)
+		return;
+
+	limited_tres = _reset_limited_tres(&assoc->usage->limited_tres);
+	_add_limited_tres(limited_tres, assoc->grp_tres_ctld);
+	_add_limited_tres(limited_tres, assoc->grp_tres_mins_ctld);
+	_add_limited_tres(limited_tres, assoc->grp_tres_run_mins_ctld);
+	_add_limited_tres(limited_tres, assoc->max_tres_ctld);
+	_add_limited_tres(limited_tres, assoc->max_tres_pn_ctld);
+	_add_limited_tres(limited_tres, assoc->max_tres_mins_ctld);
+	_add_limited_tres(limited_tres, assoc->max_tres_run_mins_ctld);
+}
+
+/* Same as _set_assoc_limited_tres() for a QOS */
+static void _set_qos_limited_tres(slurmdb_qos_rec_t *qos)
+{
+	bitstr_t *limited_tres;
+
+	if (!qos->usage || !g_tres_count)
+		return;
+
+	limited_tres = _reset_limited_tres(&qos->usage->limited_tres);
+	_add_limited_tres(limited_tres, qos->grp_tres_ctld);
+	_add_limited_tres(limited_tres, qos->grp_tres_mins_ctld);
+	_add_limited_tres(limited_tres, qos->grp_tres_run_mins_ctld);
+	_add_limited_tres(limited_tres, qos->max_tres_pa_ctld);
+	_add_limited_tres(limited_tres, qos->max_tres_pj_ctld);
+	_add_limited_tres(limited_tres, qos->max_tres_pn_ctld);
+	_add_limited_tres(limited_tres, qos->max_tres_pu_ctld);
+	_add_limited_tres(limited_tres, qos->max_tres_mins_pj_ctld);
+	_add_limited_tres(limited_tres, qos->max_tres_run_mins_pa_ctld);
+	_add_limited_tres(limited_tres, qos->max_tres_run_mins_pu_ctld);
+	_add_limited_tres(limited_tres, qos->min_tres_pj_ctld);
+}
+
 static int _set_assoc_parent_and_user(slurmdb_assoc_rec_t *assoc,
 				      int reset)
 {
@@ -3839,6 +3908,8 @@ extern int assoc_mgr_update_assocs(slurmdb_update_object_t *update, bool locked)
 
 			/* info("now rec has def of %d", rec->def_qos_id); */
 
+			_set_assoc_limited_tres(rec);
+
 			if (update_jobs && init_setup.update_assoc_notify) {
 				/* since there are some deadlock
 				   issues while inside our lock here
@@ -4179,8 +4250,16 @@ extern int assoc_mgr_update_users(slurmdb_update_object_t *update, bool locked)
 	ListIterator itr = NULL;
 	int rc = SLURM_SUCCESS;
 	uid_t pw_uid;
-	assoc_mgr_lock_t locks = { .assoc = WRITE_LOCK, .user = WRITE_LOCK,
-				   .wckey = WRITE_LOCK };
+	assoc_mgr_lock_t locks = { .user = WRITE_LOCK };
+
+	/*
+	 * Only a user rename (see _change_user_name()) touches associations
+	 * and wckeys, so don't block readers of those for other updates.
+	 */
+	if (update->type == SLURMDB_MODIFY_USER) {
+		locks.assoc = WRITE_LOCK;
+		locks.wckey = WRITE_LOCK;
+	}
 
 	if (!locked)
 		assoc_mgr_lock(&locks);
@@ -4305,7 +4384,16 @@ extern int assoc_mgr_update_qos(slurmdb_update_object_t *update, bool locked)
 	int redo_priority = 0;
 	List remove_list = NULL;
 	List update_list = NULL;
-	assoc_mgr_lock_t locks = { .assoc = WRITE_LOCK, .qos = WRITE_LOCK };
+	assoc_mgr_lock_t locks = { .qos = WRITE_LOCK };
+
+	/*
+	 * Only adding or removing a QOS changes the associations (their
+	 * valid_qos bitmaps and default QOS), so modifying a QOS or its usage
+	 * doesn't need to block association readers.
+	 */
+	if ((update->type == SLURMDB_ADD_QOS) ||
+	    (update->type == SLURMDB_REMOVE_QOS))
+		locks.assoc = WRITE_LOCK;
 
 	if (!locked)
 		assoc_mgr_lock(&locks);
@@ -4599,6 +4687,8 @@ extern int assoc_mgr_update_qos(slurmdb_update_object_t *update, bool locked)
 			if (!fuzzy_equal(object->usage_thres, NO_VAL))
 				rec->usage_thres = object->usage_thres;
 
+			_set_qos_limited_tres(rec);
+
 			if (update_jobs && init_setup.update_qos_notify) {
 				/* since there are some deadlock
 				   issues while inside our lock here
@@ -6292,6 +6382,7 @@ extern void assoc_mgr_set_assoc_tres_cnt(slurmdb_assoc_rec_t *assoc)
 				     assoc->max_tres_mins_pj, INFINITE64, 1);
 	assoc_mgr_set_tres_cnt_array(&assoc->max_tres_run_mins_ctld,
 				     assoc->max_tres_run_mins, INFINITE64, 1);
+	_set_assoc_limited_tres(assoc);
 }
 
 /* tres read lock needs to be locked before this is called. */
@@ -6325,6 +6416,7 @@ extern void assoc_mgr_set_qos_tres_cnt(slurmdb_qos_rec_t *qos)
 				     qos->max_tres_run_mins_pu, INFINITE64, 1);
 	assoc_mgr_set_tres_cnt_array(&qos->min_tres_pj_ctld,
 				     qos->min_tres_pj, INFINITE64, 1);
+	_set_qos_limited_tres(qos);
 }
 
 extern char *assoc_mgr_make_tres_str_from_array(
@@ -144,6 +144,8 @@ strong_alias(bit_fls,		slurm_bit_fls);
 strong_alias(bit_fill_gaps,	slurm_bit_fill_gaps);
 strong_alias(bit_super_set,	slurm_bit_super_set);
 strong_alias(bit_overlap,	slurm_bit_overlap);
+strong_alias(bit_overlap_any,	slurm_bit_overlap_any);
+strong_alias(bit_and_set_count,	slurm_bit_and_set_count);
 strong_alias(bit_equal,		slurm_bit_equal);
 strong_alias(bit_copy,		slurm_bit_copy);
 strong_alias(bit_pick_cnt,	slurm_bit_pick_cnt);
@@ -154,6 +156,358 @@ strong_alias(bit_copybits,	slurm_bit_copybits);
 strong_alias(bit_get_bit_num,	slurm_bit_get_bit_num);
 strong_alias(bit_get_pos_num,	slurm_bit_get_pos_num);
 
+#ifdef HAVE___BUILTIN_POPCOUNTLL
+#define hweight __builtin_popcountll
+#else
+/*
+ * Returns the hamming weight (i.e. the number of bits set) in a word.
+ * NOTE: This routine borrowed from Linux 4.9 <tools/lib/hweight.c>.
+ */
+static uint64_t
+hweight(uint64_t w)
+{
+        w -= (w >> 1) & 0x5555555555555555ul;
+        w =  (w & 0x3333333333333333ul) + ((w >> 2) & 0x3333333333333333ul);
+        w =  (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0ful;
+        return (w * 0x0101010101010101ul) >> 56;
+}
+#endif
+
+/*
+ * Word kernels used by the whole bitstring operations below. On x86_64 they
+ * are built for several instruction sets (AVX2, POPCNT, baseline) and the
+ * dynamic loader picks the best one the CPU supports at startup. Where
+ * available, GCC vector types are used to process _BIT_VEC_WORDS words per
+ * step, which the AVX2 variant does in a single instruction.
+ */
+#if defined(__x86_64__) && defined(__GLIBC__) && defined(__has_attribute)
+#  if __has_attribute(target_clones)
+#    define _bit_kernel __attribute__((target_clones("avx2","popcnt","default")))
+#  endif
+#endif
+#ifndef _bit_kernel
+#  define _bit_kernel
+#endif
+
+#ifdef __GNUC__
+typedef bitstr_t _bit_vec_t __attribute__((vector_size(32)));
+#define _BIT_VEC_WORDS	(sizeof(_bit_vec_t) / sizeof(bitstr_t))
+
+#define _vec_load(v, w)		memcpy(&(v), (w), sizeof(_bit_vec_t))
+#define _vec_store(w, v)	memcpy((w), &(v), sizeof(_bit_vec_t))
+#define _vec_or_reduce(v)	((v)[0] | (v)[1] | (v)[2] | (v)[3])
+#define _vec_and_reduce(v)	((v)[0] & (v)[1] & (v)[2] & (v)[3])
+#endif
+
+/* d[i] &= s[i] for n words */
+static _bit_kernel void _words_and(bitstr_t *d, const bitstr_t *s, bitoff_t n)
+{
+	bitoff_t i = 0;
+
+#ifdef _BIT_VEC_WORDS
+	for ( ; (i + _BIT_VEC_WORDS) <= n; i += _BIT_VEC_WORDS) {
+		_bit_vec_t v1, v2;
+
+		_vec_load(v1, d + i);
+		_vec_load(v2, s + i);
+		v1 &= v2;
+		_vec_store(d + i, v1);
+	}
+#endif
+	for ( ; i < n; i++)
+		d[i] &= s[i];
+}
+
+/* d[i] &= ~s[i] for n words */
+static _bit_kernel void _words_and_not(bitstr_t *d, const bitstr_t *s,
+				       bitoff_t n)
+{
+	bitoff_t i = 0;
+
+#ifdef _BIT_VEC_WORDS
+	for ( ; (i + _BIT_VEC_WORDS) <= n; i += _BIT_VEC_WORDS) {
+		_bit_vec_t v1, v2;
+
+		_vec_load(v1, d + i);
+		_vec_load(v2, s + i);
+		v1 &= ~v2;
+		_vec_store(d + i, v1);
+	}
+#endif
+	for ( ; i < n; i++)
+		d[i] &= ~s[i];
+}
+
+/* d[i] |= s[i] for n words */
+static _bit_kernel void _words_or(bitstr_t *d, const bitstr_t *s, bitoff_t n)
+{
+	bitoff_t i = 0;
+
+#ifdef _BIT_VEC_WORDS
+	for ( ; (i + _BIT_VEC_WORDS) <= n; i += _BIT_VEC_WORDS) {
+		_bit_vec_t v1, v2;
+
+		_vec_load(v1, d + i);
+		_vec_load(v2, s + i);
+		v1 |= v2;
+		_vec_store(d + i, v1);
+	}
+#endif
+	for ( ; i < n; i++)
+		d[i] |= s[i];
+}
+
+/* d[i] |= ~s[i] for n words */
+static _bit_kernel void _words_or_not(bitstr_t *d, const bitstr_t *s,
+				      bitoff_t n)
+{
+	bitoff_t i = 0;
+
+#ifdef _BIT_VEC_WORDS
+	for ( ; (i + _BIT_VEC_WORDS) <= n; i += _BIT_VEC_WORDS) {
+		_bit_vec_t v1, v2;
+
+		_vec_load(v1, d + i);
+		_vec_load(v2, s + i);
+		v1 |= ~v2;
+		_vec_store(d + i, v1);
+	}
+#endif
+	for ( ; i < n; i++)
+		d[i] |= ~s[i];
+}
+
+/* d[i] = ~d[i] for n words */
+static _bit_kernel void _words_not(bitstr_t *d, bitoff_t n)
+{
+	bitoff_t i = 0;
+
+#ifdef _BIT_VEC_WORDS
+	for ( ; (i + _BIT_VEC_WORDS) <= n; i += _BIT_VEC_WORDS) {
+		_bit_vec_t v1;
+
+		_vec_load(v1, d + i);
+		v1 = ~v1;
+		_vec_store(d + i, v1);
+	}
+#endif
+	for ( ; i < n; i++)
+		d[i] = ~d[i];
+}
+
+/* Count bits set in n words */
+static _bit_kernel int32_t _words_count(const bitstr_t *w, bitoff_t n)
+{
+	int32_t count = 0;
+	bitoff_t i;
+
+	for (i = 0; i < n; i++)
+		count += hweight(w[i]);
+	return count;
+}
+
+/* Count bits set in both a and b over n words */
+static _bit_kernel int32_t _words_and_count(const bitstr_t *a,
+					    const bitstr_t *b, bitoff_t n)
+{
+	int32_t count = 0;
+	bitoff_t i;
+
+	for (i = 0; i < n; i++)
+		count += hweight(a[i] & b[i]);
+	return count;
+}
+
+/* d[i] &= s[i] for n words, returning the count of bits set in the result */
+static _bit_kernel int32_t _words_and_store_count(bitstr_t *d,
+						  const bitstr_t *s, bitoff_t n)
+{
+	int32_t count = 0;
+	bitoff_t i;
+
+	for (i = 0; i < n; i++) {
+		d[i] &= s[i];
+		count += hweight(d[i]);
+	}
+	return count;
+}
+
+/* Return true if any bit is set in both a and b over n words */
+static _bit_kernel bool _words_and_any(const bitstr_t *a, const bitstr_t *b,
+				       bitoff_t n)
+{
+	bitoff_t i = 0;
+
+#ifdef _BIT_VEC_WORDS
+	for ( ; (i + _BIT_VEC_WORDS) <= n; i += _BIT_VEC_WORDS) {
+		_bit_vec_t v1, v2;
+
+		_vec_load(v1, a + i);
+		_vec_load(v2, b + i);
+		v1 &= v2;
+		if (_vec_or_reduce(v1))
+			return true;
+	}
+#endif
+	for ( ; i < n; i++) {
+		if (a[i] & b[i])
+			return true;
+	}
+	return false;
+}
+
+/* Return true if any bit is set in a but not in b over n words */
+static _bit_kernel bool _words_and_not_any(const bitstr_t *a,
+					   const bitstr_t *b, bitoff_t n)
+{
+	bitoff_t i = 0;
+
+#ifdef _BIT_VEC_WORDS
+	for ( ; (i + _BIT_VEC_WORDS) <= n; i += _BIT_VEC_WORDS) {
+		_bit_vec_t v1, v2;
+
+		_vec_load(v1, a + i);
+		_vec_load(v2, b + i);
+		v1 &= ~v2;
+		if (_vec_or_reduce(v1))
+			return true;
+	}
+#endif
+	for ( ; i < n; i++) {
+		if (a[i] & ~b[i])
+			return true;
+	}
+	return false;
+}
+
+/* Return the index of the first non-zero word of n words, n if none */
+static _bit_kernel bitoff_t _words_first_set(const bitstr_t *w, bitoff_t n)
+{
+	bitoff_t i = 0;
+
+#ifdef _BIT_VEC_WORDS
+	for ( ; (i + _BIT_VEC_WORDS) <= n; i += _BIT_VEC_WORDS) {
+		_bit_vec_t v1;
+
+		_vec_load(v1, w + i);
+		if (_vec_or_reduce(v1))
+			break;
+	}
+#endif
+	while ((i < n) && (w[i] == 0))
+		i++;
+	return i;
+}
+
+/* Return the index of the first word of n words not all ones, n if none */
+static _bit_kernel bitoff_t _words_first_clear(const bitstr_t *w, bitoff_t n)
+{
+	bitoff_t i = 0;
+
+#ifdef _BIT_VEC_WORDS
+	for ( ; (i + _BIT_VEC_WORDS) <= n; i += _BIT_VEC_WORDS) {
+		_bit_vec_t v1;
+
+		_vec_load(v1, w + i);
+		if (_vec_and_reduce(v1) != (bitstr_t) BITSTR_MAXVAL)
+			break;
+	}
+#endif
+	while ((i < n) && (w[i] == (bitstr_t) BITSTR_MAXVAL))
+		i++;
+	return i;
+}
+
+/* Position of the first bit set in a non-zero word */
+static inline bitoff_t _word_ffs(bitstr_t word)
+{
+#if HAVE___BUILTIN_CLZLL && (defined SLURM_BIGENDIAN)
+	return __builtin_clzll(word);
+#elif HAVE___BUILTIN_CTZLL && (!defined SLURM_BIGENDIAN)
+	return __builtin_ctzll(word);
+#else
+	bitoff_t bit;
+
+	for (bit = 0; !(word & _bit_mask(bit)); bit++)
+		;
+	return bit;
+#endif
+}
+
+/* Position of the last bit set in a non-zero word */
+static inline bitoff_t _word_fls(bitstr_t word)
+{
+#if HAVE___BUILTIN_CTZLL && (defined SLURM_BIGENDIAN)
+	return BITSTR_MAXPOS - __builtin_ctzll(word);
+#elif HAVE___BUILTIN_CLZLL && (!defined SLURM_BIGENDIAN)
+	return BITSTR_MAXPOS - __builtin_clzll(word);
+#else
+	bitoff_t bit;
+
+	for (bit = BITSTR_MAXPOS; !(word & _bit_mask(bit)); bit--)
+		;
+	return bit;
+#endif
+}
+
+/* Mask of the valid bits in the last word of a bitstring of nbits bits */
+static inline bitstr_t _last_word_mask(bitoff_t nbits)
+{
+	int rem = nbits & BITSTR_MAXPOS;
+
+	if (!rem)
+		return (bitstr_t) BITSTR_MAXVAL;
+#ifdef SLURM_BIGENDIAN
+	return (bitstr_t) ~(UINT64_MAX >> rem);
+#else
+	return (bitstr_t) ((UINT64_C(1) << rem) - 1);
+#endif
+}
+
+/*
+ * Find the first run of n contiguous bits set (or clear) in b which lies
+ * within [start, end). Whole words that are all set or all clear are
+ * handled 64 bits at a time.
+ *   RETURN	position of first bit in run (-1 if none found)
+ */
+static bitoff_t _find_run(bitstr_t *b, bitoff_t start, bitoff_t end,
+			  int32_t n, bool set)
+{
+	bitoff_t bit = start, cnt = 0;
+	bitstr_t word;
+
+	while (bit < end) {
+		word = b[_bit_word(bit)];
+		if (!set)
+			word = ~word;
+		if (!(bit & BITSTR_MAXPOS) &&
+		    ((bit + BITSTR_MAXPOS) < end)) {
+			if (word == (bitstr_t) BITSTR_MAXVAL) {
+				cnt += BITSTR_MAXPOS + 1;
+				bit += BITSTR_MAXPOS + 1;
+				if (cnt >= n)
+					return bit - cnt;
+				continue;
+			}
+			if (word == 0) {
+				cnt = 0;
+				bit += BITSTR_MAXPOS + 1;
+				continue;
+			}
+		}
+		if (word & _bit_mask(bit)) {
+			bit++;
+			if (++cnt >= n)
+				return bit - cnt;
+		} else {
+			cnt = 0;
+			bit++;
+		}
+	}
+
+	return -1;
+}
+
 /*
  * Allocate a bitstring.
  *   nbits (IN)		valid bits in new bitstring, initialized to all clear
@@ -331,26 +685,21 @@ bit_clear_all(bitstr_t *b)
 bitoff_t
 bit_ffc(bitstr_t *b)
 {
-	bitoff_t bit = 0, value = -1;
+	bitoff_t word, nwords, value;
 
 	_assert_bitstr_valid(b);
 
-	while (bit < _bitstr_bits(b) && value == -1) {
-		int32_t word = _bit_word(bit);
+	nwords = _bitstr_words(_bitstr_bits(b)) - BITSTR_OVERHEAD;
+	word = _words_first_clear(b + BITSTR_OVERHEAD, nwords);
+	if (word == nwords)
+		return -1;
 
-		if (b[word] == BITSTR_MAXVAL) {
-			bit += sizeof(bitstr_t)*8;
-			continue;
-		}
-		while (bit < _bitstr_bits(b) && _bit_word(bit) == word) {
-			if (!bit_test(b, bit)) {
-				value = bit;
-				break;
-			}
-			bit++;
-		}
-	}
-	return value;
+	value = (word << BITSTR_SHIFT) +
+		_word_ffs(~b[word + BITSTR_OVERHEAD]);
+	if (value < _bitstr_bits(b))
+		return value;
+	else
+		return -1;
 }
 
 /* Find the first n contiguous bits clear in b.
@@ -361,26 +710,10 @@ bit_ffc(bitstr_t *b)
 bitoff_t
 bit_nffc(bitstr_t *b, int32_t n)
 {
-	bitoff_t value = -1;
-	bitoff_t bit;
-	int32_t cnt = 0;
-
 	_assert_bitstr_valid(b);
 	assert(n > 0 && n < _bitstr_bits(b));
 
-	for (bit = 0; bit < _bitstr_bits(b); bit++) {
-		if (bit_test(b, bit)) {		/* fail */
-			cnt = 0;
-		} else {
-			cnt++;
-			if (cnt >= n) {
-				value = bit - (cnt - 1);
-				break;
-			}
-		}
-	}
-
-	return value;
+	return _find_run(b, 0, _bitstr_bits(b), n, false);
 }
 
 /* Find n contiguous bits clear in b starting at some offset.
@@ -392,9 +725,7 @@ bit_nffc(bitstr_t *b, int32_t n)
 bitoff_t
 bit_noc(bitstr_t *b, int32_t n, int32_t seed)
 {
-	bitoff_t value = -1;
-	bitoff_t bit;
-	int32_t cnt = 0;
+	bitoff_t value;
 
 	_assert_bitstr_valid(b);
 	assert(n > 0 && n <= _bitstr_bits(b));
@@ -402,34 +733,13 @@ bit_noc(bitstr_t *b, int32_t n, int32_t seed)
 	if ((seed + n) >= _bitstr_bits(b))
 		seed = _bitstr_bits(b);	/* skip offset test, too small */
 
-	for (bit = seed; bit < _bitstr_bits(b); bit++) {	/* start at offset */
-		if (bit_test(b, bit)) {		/* fail */
-			cnt = 0;
-		} else {
-			cnt++;
-			if (cnt >= n) {
-				value = bit - (cnt - 1);
-				return value;
-			}
-		}
-	}
-
-	cnt = 0;	/* start at beginning */
-	for (bit = 0; bit < _bitstr_bits(b); bit++) {
-		if (bit_test(b, bit)) {		/* fail */
-			if (bit >= seed)
-				break;
-			cnt = 0;
-		} else {
-			cnt++;
-			if (cnt >= n) {
-				value = bit - (cnt - 1);
-				return value;
-			}
-		}
-	}
+	/* start at offset */
+	value = _find_run(b, seed, _bitstr_bits(b), n, false);
+	if (value != -1)
+		return value;
 
-	return -1;
+	/* start at beginning, for a run starting before the offset */
+	return _find_run(b, 0, MIN(seed + n - 1, _bitstr_bits(b)), n, false);
 }
 
 /* Find the first n contiguous bits set in b.
@@ -440,26 +750,10 @@ bit_noc(bitstr_t *b, int32_t n, int32_t seed)
 bitoff_t
 bit_nffs(bitstr_t *b, int32_t n)
 {
-	bitoff_t value = -1;
-	bitoff_t bit;
-	int32_t cnt = 0;
-
 	_assert_bitstr_valid(b);
 	assert(n > 0 && n <= _bitstr_bits(b));
 
-	for (bit = 0; bit <= _bitstr_bits(b) - n; bit++) {
-		if (!bit_test(b, bit)) {	/* fail */
-			cnt = 0;
-		} else {
-			cnt++;
-			if (cnt >= n) {
-				value = bit - (cnt - 1);
-				break;
-			}
-		}
-	}
-
-	return value;
+	return _find_run(b, 0, _bitstr_bits(b) - n + 1, n, true);
 }
 
 /*
@@ -470,31 +764,16 @@ bit_nffs(bitstr_t *b, int32_t n)
 bitoff_t
 bit_ffs(bitstr_t *b)
 {
-	bitoff_t bit = 0, value = -1;
+	bitoff_t word, nwords, value;
 
 	_assert_bitstr_valid(b);
 
-	while (bit < _bitstr_bits(b) && value == -1) {
-		int32_t word = _bit_word(bit);
+	nwords = _bitstr_words(_bitstr_bits(b)) - BITSTR_OVERHEAD;
+	word = _words_first_set(b + BITSTR_OVERHEAD, nwords);
+	if (word == nwords)
+		return -1;
 
-		if (b[word] == 0) {
-			bit += sizeof(bitstr_t)*8;
-			continue;
-		}
-#if HAVE___BUILTIN_CLZLL && (defined SLURM_BIGENDIAN)
-		value = bit + __builtin_clzll(b[word]);
-#elif HAVE___BUILTIN_CTZLL && (!defined SLURM_BIGENDIAN)
-		value = bit + __builtin_ctzll(b[word]);
-#else
-		while (bit < _bitstr_bits(b) && _bit_word(bit) == word) {
-			if (bit_test(b, bit)) {
-				value = bit;
-				break;
-			}
-			bit++;
-		}
-#endif
-	}
+	value = (word << BITSTR_SHIFT) + _word_ffs(b[word + BITSTR_OVERHEAD]);
 	if (value < _bitstr_bits(b))
 		return value;
 	else
@@ -509,45 +788,24 @@ bit_ffs(bitstr_t *b)
 bitoff_t
 bit_fls(bitstr_t *b)
 {
-	bitoff_t bit, value = -1;
-	int32_t word;
+	bitoff_t word;
+	bitstr_t value;
 
 	_assert_bitstr_valid(b);
 
 	if (_bitstr_bits(b) == 0)	/* empty bitstring */
 		return -1;
 
-	bit = _bitstr_bits(b) - 1;	/* zero origin */
-
-	while (bit >= 0 && 		/* test partitial words */
-		(_bit_word(bit) == _bit_word(bit + 1))) {
-		if (bit_test(b, bit)) {
-			value = bit;
-			break;
-		}
-		bit--;
+	/* ignore any bits past the end in the last word */
+	word = _bit_word(_bitstr_bits(b) - 1);
+	value = b[word] & _last_word_mask(_bitstr_bits(b));
+	while (value == 0) {
+		if (--word < BITSTR_OVERHEAD)
+			return -1;
+		value = b[word];
 	}
-	while (bit >= 0 && value == -1) {	/* test whole words */
-		word = _bit_word(bit);
-		if (b[word] == 0) {
-			bit -= sizeof(bitstr_t) * 8;
-			continue;
-		}
-#if HAVE___BUILTIN_CTZLL && (defined SLURM_BIGENDIAN)
-		value = bit - __builtin_ctzll(b[word]);
-#elif HAVE___BUILTIN_CLZLL && (!defined SLURM_BIGENDIAN)
-		value = bit - __builtin_clzll(b[word]);
-#else
-		while (bit >= 0) {
-			if (bit_test(b, bit)) {
-				value = bit;
-				break;
-			}
-			bit--;
-		}
-#endif
-	}
-	return value;
+
+	return ((word - BITSTR_OVERHEAD) << BITSTR_SHIFT) + _word_fls(value);
 }
 
 /*
@@ -577,17 +835,16 @@ bit_fill_gaps(bitstr_t *b)
 int
 bit_super_set(bitstr_t *b1, bitstr_t *b2)
 {
-	bitoff_t bit;
+	bitoff_t nwords;
 
 	_assert_bitstr_valid(b1);
 	_assert_bitstr_valid(b2);
 	assert(_bitstr_bits(b1) == _bitstr_bits(b2));
 
-	for (bit = 0; bit < _bitstr_bits(b1); bit += sizeof(bitstr_t)*8) {
-		if (b1[_bit_word(bit)] != (b1[_bit_word(bit)] &
-		                           b2[_bit_word(bit)]))
-			return 0;
-	}
+	nwords = _bitstr_words(_bitstr_bits(b1)) - BITSTR_OVERHEAD;
+	if (_words_and_not_any(b1 + BITSTR_OVERHEAD, b2 + BITSTR_OVERHEAD,
+			       nwords))
+		return 0;
 
 	return 1;
 }
@@ -598,7 +855,7 @@ bit_super_set(bitstr_t *b1, bitstr_t *b2)
 extern int
 bit_equal(bitstr_t *b1, bitstr_t *b2)
 {
-	bitoff_t bit;
+	size_t len;
 
 	_assert_bitstr_valid(b1);
 	_assert_bitstr_valid(b2);
@@ -606,10 +863,10 @@ bit_equal(bitstr_t *b1, bitstr_t *b2)
 	if (_bitstr_bits(b1) != _bitstr_bits(b2))
 		return 0;
 
-	for (bit = 0; bit < _bitstr_bits(b1); bit += sizeof(bitstr_t)*8) {
-		if (b1[_bit_word(bit)] != b2[_bit_word(bit)])
-			return 0;
-	}
+	len = (_bitstr_words(_bitstr_bits(b1)) - BITSTR_OVERHEAD) *
+	      sizeof(bitstr_t);
+	if (memcmp(&b1[BITSTR_OVERHEAD], &b2[BITSTR_OVERHEAD], len))
+		return 0;
 
 	return 1;
 }
@@ -624,14 +881,43 @@ bit_equal(bitstr_t *b1, bitstr_t *b2)
 void
 bit_and(bitstr_t *b1, bitstr_t *b2)
 {
-	bitoff_t bit;
+	_assert_bitstr_valid(b1);
+	_assert_bitstr_valid(b2);
+	assert(_bitstr_bits(b1) == _bitstr_bits(b2));
+
+	_words_and(b1 + BITSTR_OVERHEAD, b2 + BITSTR_OVERHEAD,
+	   _bitstr_words(_bitstr_bits(b1)) - BITSTR_OVERHEAD);
+}
+
+/*
+ * b1 &= b2, returning the number of bits set in the result
+ * Equivalent to bit_and() followed by bit_set_count(), in one pass.
+ *   b1 (IN/OUT)	first string
+ *   b2 (IN)		second bitstring
+ */
+int32_t
+bit_and_set_count(bitstr_t *b1, bitstr_t *b2)
+{
+	int32_t count;
+	bitoff_t bit, bit_cnt, nwords;
 
 	_assert_bitstr_valid(b1);
 	_assert_bitstr_valid(b2);
 	assert(_bitstr_bits(b1) == _bitstr_bits(b2));
 
-	for (bit = 0; bit < _bitstr_bits(b1); bit += sizeof(bitstr_t)*8)
-		b1[_bit_word(bit)] &= b2[_bit_word(bit)];
+	bit_cnt = _bitstr_bits(b1);
+	nwords = bit_cnt >> BITSTR_SHIFT;
+	count = _words_and_store_count(b1 + BITSTR_OVERHEAD,
+				       b2 + BITSTR_OVERHEAD, nwords);
+	if ((nwords + BITSTR_OVERHEAD) < _bitstr_words(bit_cnt)) {
+		b1[nwords + BITSTR_OVERHEAD] &= b2[nwords + BITSTR_OVERHEAD];
+		for (bit = nwords << BITSTR_SHIFT; bit < bit_cnt; bit++) {
+			if (bit_test(b1, bit))
+				count++;
+		}
+	}
+
+	return count;
 }
 
 /*
@@ -641,14 +927,12 @@ bit_and(bitstr_t *b1, bitstr_t *b2)
  */
 void bit_and_not(bitstr_t *b1, bitstr_t *b2)
 {
-	bitoff_t bit;
-
 	_assert_bitstr_valid(b1);
 	_assert_bitstr_valid(b2);
 	assert(_bitstr_bits(b1) == _bitstr_bits(b2));
 
-	for (bit = 0; bit < _bitstr_bits(b1); bit += sizeof(bitstr_t)*8)
-		b1[_bit_word(bit)] &= ~b2[_bit_word(bit)];
+	_words_and_not(b1 + BITSTR_OVERHEAD, b2 + BITSTR_OVERHEAD,
+	   _bitstr_words(_bitstr_bits(b1)) - BITSTR_OVERHEAD);
 }
 
 /*
@@ -658,12 +942,10 @@ void bit_and_not(bitstr_t *b1, bitstr_t *b2)
 void
 bit_not(bitstr_t *b)
 {
-	bitoff_t bit;
-
 	_assert_bitstr_valid(b);
 
-	for (bit = 0; bit < _bitstr_bits(b); bit += sizeof(bitstr_t)*8)
-		b[_bit_word(bit)] = ~b[_bit_word(bit)];
+	_words_not(b + BITSTR_OVERHEAD,
+		   _bitstr_words(_bitstr_bits(b)) - BITSTR_OVERHEAD);
 }
 
 /*
@@ -674,14 +956,12 @@ bit_not(bitstr_t *b)
 void
 bit_or(bitstr_t *b1, bitstr_t *b2)
 {
-	bitoff_t bit;
-
 	_assert_bitstr_valid(b1);
 	_assert_bitstr_valid(b2);
 	assert(_bitstr_bits(b1) == _bitstr_bits(b2));
 
-	for (bit = 0; bit < _bitstr_bits(b1); bit += sizeof(bitstr_t)*8)
-		b1[_bit_word(bit)] |= b2[_bit_word(bit)];
+	_words_or(b1 + BITSTR_OVERHEAD, b2 + BITSTR_OVERHEAD,
+	   _bitstr_words(_bitstr_bits(b1)) - BITSTR_OVERHEAD);
 }
 
 /*
@@ -691,14 +971,12 @@ bit_or(bitstr_t *b1, bitstr_t *b2)
  */
 void bit_or_not(bitstr_t *b1, bitstr_t *b2)
 {
-	bitoff_t bit;
-
 	_assert_bitstr_valid(b1);
 	_assert_bitstr_valid(b2);
 	assert(_bitstr_bits(b1) == _bitstr_bits(b2));
 
-	for (bit = 0; bit < _bitstr_bits(b1); bit += sizeof(bitstr_t)*8)
-		b1[_bit_word(bit)] |= ~b2[_bit_word(bit)];
+	_words_or_not(b1 + BITSTR_OVERHEAD, b2 + BITSTR_OVERHEAD,
+	   _bitstr_words(_bitstr_bits(b1)) - BITSTR_OVERHEAD);
 }
 
 /*
@@ -735,23 +1013,6 @@ bit_copybits(bitstr_t *dest, bitstr_t *src)
 	memcpy(&dest[BITSTR_OVERHEAD], &src[BITSTR_OVERHEAD], len);
 }
 
-#ifdef HAVE___BUILTIN_POPCOUNTLL
-#define hweight __builtin_popcountll
-#else
-/*
- * Returns the hamming weight (i.e. the number of bits set) in a word.
- * NOTE: This routine borrowed from Linux 4.9 <tools/lib/hweight.c>.
- */
-static uint64_t
-hweight(uint64_t w)
-{
-        w -= (w >> 1) & 0x5555555555555555ul;
-        w =  (w & 0x3333333333333333ul) + ((w >> 2) & 0x3333333333333333ul);
-        w =  (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0ful;
-        return (w * 0x0101010101010101ul) >> 56;
-}
-#endif
-
 /*
  * Count the number of bits set in bitstring.
  *   b (IN)		bitstring to check
@@ -760,17 +1021,14 @@ hweight(uint64_t w)
 int32_t
 bit_set_count(bitstr_t *b)
 {
-	int32_t count = 0;
+	int32_t count;
 	bitoff_t bit, bit_cnt;
-	int32_t word_size = sizeof(bitstr_t) * 8;
 
 	_assert_bitstr_valid(b);
 
 	bit_cnt = _bitstr_bits(b);
-	for (bit = 0; (bit + word_size) <= bit_cnt; bit += word_size) {
-		count += hweight(b[_bit_word(bit)]);
-	}
-	for ( ; bit < bit_cnt; bit++) {
+	count = _words_count(b + BITSTR_OVERHEAD, bit_cnt >> BITSTR_SHIFT);
+	for (bit = bit_cnt & ~((bitoff_t) BITSTR_MAXPOS); bit < bit_cnt; bit++) {
 		if (bit_test(b, bit))
 			count++;
 	}
@@ -800,8 +1058,10 @@ bit_set_count_range(bitstr_t *b, int32_t start, int32_t end)
 		if (bit_test(b, bit))
 			count++;
 	}
-	for (; (bit + word_size) <= end ; bit += word_size) {
-		count += hweight(b[_bit_word(bit)]);
+	if ((bit + word_size) <= end) {
+		count += _words_count(b + _bit_word(bit),
+				      (end - bit) >> BITSTR_SHIFT);
+		bit += ((end - bit) >> BITSTR_SHIFT) << BITSTR_SHIFT;
 	}
 	for ( ; bit < end; bit++) {
 		if (bit_test(b, bit))
@@ -817,21 +1077,17 @@ bit_set_count_range(bitstr_t *b, int32_t start, int32_t end)
 extern int32_t
 bit_overlap(bitstr_t *b1, bitstr_t *b2)
 {
-	int32_t count = 0;
+	int32_t count;
 	bitoff_t bit, bit_cnt;
-	int32_t word_size = sizeof(bitstr_t) * 8;
 
 	_assert_bitstr_valid(b1);
 	_assert_bitstr_valid(b2);
 	assert(_bitstr_bits(b1) == _bitstr_bits(b2));
 
 	bit_cnt = _bitstr_bits(b1);
-	for (bit = 0; bit < bit_cnt; bit += word_size) {
-		if ((bit + word_size - 1) >= bit_cnt)
-			break;
-		count += hweight(b1[_bit_word(bit)] & b2[_bit_word(bit)]);
-	}
-	for ( ; bit < bit_cnt; bit++) {
+	count = _words_and_count(b1 + BITSTR_OVERHEAD, b2 + BITSTR_OVERHEAD,
+				 bit_cnt >> BITSTR_SHIFT);
+	for (bit = bit_cnt & ~((bitoff_t) BITSTR_MAXPOS); bit < bit_cnt; bit++) {
 		if (bit_test(b1, bit) && bit_test(b2, bit))
 			count++;
 	}
@@ -839,6 +1095,31 @@ bit_overlap(bitstr_t *b1, bitstr_t *b2)
 	return count;
 }
 
+/*
+ * return 1 if any bit set in b1 is also set in b2, 0 if no overlap
+ * Cheaper than bit_overlap() as it stops at the first common bit.
+ */
+extern int
+bit_overlap_any(bitstr_t *b1, bitstr_t *b2)
+{
+	bitoff_t bit, bit_cnt;
+
+	_assert_bitstr_valid(b1);
+	_assert_bitstr_valid(b2);
+	assert(_bitstr_bits(b1) == _bitstr_bits(b2));
+
+	bit_cnt = _bitstr_bits(b1);
+	if (_words_and_any(b1 + BITSTR_OVERHEAD, b2 + BITSTR_OVERHEAD,
+			   bit_cnt >> BITSTR_SHIFT))
+		return 1;
+	for (bit = bit_cnt & ~((bitoff_t) BITSTR_MAXPOS); bit < bit_cnt; bit++) {
+		if (bit_test(b1, bit) && bit_test(b2, bit))
+			return 1;
+	}
+
+	return 0;
+}
+
 /*
  * Count the number of bits clear in bitstring.
  *   b (IN)		bitstring to check
@@ -877,25 +1158,36 @@ bit_clear_count_range(bitstr_t *b, int32_t start, int32_t end)
 int32_t
 bit_nset_max_count(bitstr_t *b)
 {
-	bitoff_t bit;
+	bitoff_t bit = 0;
 	int32_t  cnt = 0;
 	int32_t  maxcnt = 0;
 	uint32_t bitsize;
+	bitstr_t word;
 
 	_assert_bitstr_valid(b);
 	bitsize = _bitstr_bits(b);
 
-	for (bit = 0; bit < bitsize; bit++) {
-		if (!bit_test(b, bit)) {	/* no longer continuous */
-			cnt = 0;
+	while (bit < bitsize) {
+		word = b[_bit_word(bit)];
+		if (!(bit & BITSTR_MAXPOS) &&
+		    ((bit + BITSTR_MAXPOS) < bitsize) &&
+		    ((word == 0) || (word == (bitstr_t) BITSTR_MAXVAL))) {
+			if (word == 0)
+				cnt = 0;
+			else
+				cnt += BITSTR_MAXPOS + 1;
+			bit += BITSTR_MAXPOS + 1;
 		} else {
-			cnt++;
-			if (cnt > maxcnt) {
-				maxcnt = cnt;
-			}
+			if (!(word & _bit_mask(bit)))	/* no longer continuous */
+				cnt = 0;
+			else
+				cnt++;
+			bit++;
 		}
+		if (cnt > maxcnt)
+			maxcnt = cnt;
 		if (cnt == 0 && ((bitsize - bit) < maxcnt)) {
-		    	break;			/* already found max */
+			break;			/* already found max */
 		}
 	}
 
@@ -157,7 +157,14 @@ typedef struct slurm_gres_context {
  * gres_step_state_t */
 typedef struct gres_state {
 	uint32_t	plugin_id;
+	int		gres_id;	/* index in gres_context[], -1 if no
+					 * plugin is configured for plugin_id */
 	void		*gres_data;
+	/* Node's GRES indexed by gres_id, kept on the first record of a
+	 * node's gres_list only and rebuilt when the list changes */
+	struct gres_state **node_table;
+	int		node_table_cnt;	/* list_count() when built */
+	int		node_table_size; /* gres_context_cnt when built */
 } gres_state_t;
 
 typedef struct gres_search_key {
@@ -185,6 +192,9 @@ static bool have_gpu = false, have_mps = false;
 static uint32_t gpu_plugin_id = NO_VAL, mps_plugin_id = NO_VAL;
 
 /* Local functions */
+static bool *	_build_avail_cores_by_sock(bitstr_t *core_bitmap,
+					   uint16_t sockets,
+					   uint16_t cores_per_sock);
 static gres_node_state_t *
 		_build_gres_node_state(void);
 static uint32_t **_build_tasks_per_node_sock(struct job_resources *job_res,
@@ -204,6 +214,7 @@ static uint32_t	_get_task_cnt_node(uint32_t **tasks_per_node_socket,
 				   int node_inx, int sock_cnt);
 static uint64_t	_get_tot_gres_cnt(uint32_t plugin_id, uint64_t *set_cnt);
 static int	_gres_find_id(void *x, void *key);
+static int	_gres_id(uint32_t plugin_id);
 static int	_gres_find_job_by_key(void *x, void *key);
 static int	_gres_find_step_by_key(void *x, void *key);
 static void	_gres_job_list_delete(void *list_element);
@@ -279,6 +290,12 @@ static int	_unload_gres_plugin(slurm_gres_context_t *plugin_context);
 static void	_validate_config(slurm_gres_context_t *context_ptr);
 static int	_validate_file(char *path_name, char *gres_name);
 static void	_validate_links(gres_slurmd_conf_t *p);
+static bitstr_t *_topo_sock_build(bitstr_t *topo_core_bitmap,
+				  uint16_t sockets, uint16_t cores_per_sock,
+				  int tot_cores);
+static void	_topo_sock_clear(gres_node_state_t *node_gres_ptr);
+static bitstr_t **_topo_sock_map(gres_node_state_t *node_gres_ptr,
+				 uint16_t sockets, uint16_t cores_per_sock);
 static void	_validate_gres_node_cores(gres_node_state_t *node_gres_ptr,
 					  int cpus_ctld, char *node_name);
 static int	_valid_gres_type(char *gres_name, gres_node_state_t *gres_data,
@@ -300,6 +317,82 @@ extern uint32_t gres_plugin_build_id(char *name)
 	return id;
 }
 
+/*
+ * Return the GRES id of a plugin_id, its index in gres_context[] as set up by
+ * gres_plugin_init(), or -1 if no such GRES plugin is configured.
+ * gres_context_lock must be locked.
+ */
+static int _gres_id(uint32_t plugin_id)
+{
+	int i;
+
+	for (i = 0; i < gres_context_cnt; i++) {
+		if (gres_context[i].plugin_id == plugin_id)
+			return i;
+	}
+	return -1;
+}
+
+/*
+ * Return a node's GRES records indexed by GRES id, or NULL if the node has
+ * none. The table is kept on the first record of the node's gres_list and
+ * rebuilt only when records have been added to the list or the GRES plugins
+ * have changed since it was built. Records are never removed from a node's
+ * gres_list other than by destroying the list. As with a search of the list,
+ * the first record of any GRES id is used.
+ * gres_context_lock must be locked.
+ */
+static gres_state_t **_node_gres_table(List node_gres_list)
+{
+	gres_state_t *head, *gres_ptr;
+	ListIterator iter;
+	int cnt;
+
+	if (!node_gres_list || !(head = list_peek(node_gres_list)))
+		return NULL;
+
+	cnt = list_count(node_gres_list);
+	if (head->node_table && (head->node_table_cnt == cnt) &&
+	    (head->node_table_size == gres_context_cnt))
+		return head->node_table;
+
+	xfree(head->node_table);
+	head->node_table = xmalloc(sizeof(gres_state_t *) *
+				   MAX(gres_context_cnt, 1));
+	iter = list_iterator_create(node_gres_list);
+	while ((gres_ptr = (gres_state_t *) list_next(iter))) {
+		if ((gres_ptr->gres_id < 0) ||
+		    (gres_ptr->gres_id >= gres_context_cnt) ||
+		    head->node_table[gres_ptr->gres_id])
+			continue;
+		head->node_table[gres_ptr->gres_id] = gres_ptr;
+	}
+	list_iterator_destroy(iter);
+	head->node_table_cnt = cnt;
+	head->node_table_size = gres_context_cnt;
+
+	return head->node_table;
+}
+
+/*
+ * Find a node's record for the GRES with the given plugin_id and GRES id
+ * gres_context_lock must be locked.
+ */
+static gres_state_t *_find_node_gres(List node_gres_list, uint32_t plugin_id,
+				     int gres_id)
+{
+	gres_state_t **node_table;
+
+	if (gres_id < 0) {
+		/* No plugin, as when GresTypes has changed */
+		return list_find_first(node_gres_list, _gres_find_id,
+				       &plugin_id);
+	}
+	if (!(node_table = _node_gres_table(node_gres_list)))
+		return NULL;
+	return node_table[gres_id];
+}
+
 static int _gres_find_id(void *x, void *key)
 {
 	uint32_t *plugin_id = (uint32_t *)key;
@@ -1451,9 +1544,11 @@ static void _gres_node_list_delete(void *list_element)
 	gres_node_state_t *gres_node_ptr;
 
 	gres_ptr = (gres_state_t *) list_element;
+	xfree(gres_ptr->node_table);
 	gres_node_ptr = (gres_node_state_t *) gres_ptr->gres_data;
 	FREE_NULL_BITMAP(gres_node_ptr->gres_bit_alloc);
 	xfree(gres_node_ptr->gres_used);
+	_topo_sock_clear(gres_node_ptr);
 	if (gres_node_ptr->links_cnt) {
 		for (i = 0; i < gres_node_ptr->link_len; i++)
 			xfree(gres_node_ptr->links_cnt[i]);
@@ -1846,6 +1941,7 @@ extern int gres_plugin_init_node_config(char *node_name, char *orig_config,
 		if (gres_ptr == NULL) {
 			gres_ptr = xmalloc(sizeof(gres_state_t));
 			gres_ptr->plugin_id = gres_context[i].plugin_id;
+			gres_ptr->gres_id = i;
 			list_append(*gres_list, gres_ptr);
 		}
 
@@ -2024,6 +2120,7 @@ static int _node_config_validate(char *node_name, char *orig_config,
 	}
 	if (updated_config == false)
 		return rc;
+	_topo_sock_clear(gres_data);
 
 	if ((set_cnt == 0) && (set_cnt != gres_data->topo_cnt)) {
 		/* Need to clear topology info */
@@ -2274,6 +2371,7 @@ static int _node_config_validate(char *node_name, char *orig_config,
 		      "%"PRIu64" found, ignoring topology support",
 		      context_ptr->gres_type, node_name,
 		      gres_data->gres_cnt_config, gres_data->gres_cnt_found);
+		_topo_sock_clear(gres_data);
 		if (gres_data->topo_core_bitmap) {
 			for (i = 0; i < gres_data->topo_cnt; i++) {
 				if (gres_data->topo_core_bitmap) {
@@ -2359,6 +2457,7 @@ extern int gres_plugin_node_config_validate(char *node_name,
 		if (gres_ptr == NULL) {
 			gres_ptr = xmalloc(sizeof(gres_state_t));
 			gres_ptr->plugin_id = gres_context[i].plugin_id;
+			gres_ptr->gres_id = i;
 			list_append(*gres_list, gres_ptr);
 		}
 		rc2 = _node_config_validate(node_name, orig_config, new_config,
@@ -2456,6 +2555,7 @@ extern void gres_plugin_node_feature(char *node_name,
 		if (gres_ptr == NULL) {
 			gres_ptr = xmalloc(sizeof(gres_state_t));
 			gres_ptr->plugin_id = plugin_id;
+			gres_ptr->gres_id = _gres_id(plugin_id);
 			gres_ptr->gres_data = _build_gres_node_state();
 			list_append(*gres_list, gres_ptr);
 		}
@@ -2593,6 +2693,7 @@ static void _sync_node_mps_to_gpu(gres_state_t *mps_gres_ptr,
 			bit_realloc(mps_gres_data->gres_bit_alloc, gpu_cnt);
 
 	/* Free any excess gres/mps topo records */
+	_topo_sock_clear(mps_gres_data);
 	for (i = gpu_cnt; i < mps_gres_data->topo_cnt; i++) {
 		if (mps_gres_data->topo_core_bitmap)
 			FREE_NULL_BITMAP(mps_gres_data->topo_core_bitmap[i]);
@@ -2819,6 +2920,7 @@ extern int gres_plugin_node_state_unpack(List *gres_list, Buf buffer,
 		}
 		gres_ptr = xmalloc(sizeof(gres_state_t));
 		gres_ptr->plugin_id = gres_context[i].plugin_id;
+		gres_ptr->gres_id = i;
 		gres_ptr->gres_data = gres_node_ptr;
 		list_append(*gres_list, gres_ptr);
 	}
@@ -2888,6 +2990,19 @@ static void *_node_state_dup(void *gres_data)
 				xstrdup(gres_ptr->topo_type_name[i]);
 		}
 	}
+	if (gres_ptr->topo_sock_bitmap) {
+		new_gres->topo_sock_cnt     = gres_ptr->topo_sock_cnt;
+		new_gres->topo_sock_sockets = gres_ptr->topo_sock_sockets;
+		new_gres->topo_sock_cores   = gres_ptr->topo_sock_cores;
+		new_gres->topo_sock_bitmap  = xmalloc(gres_ptr->topo_sock_cnt *
+						      sizeof(bitstr_t *));
+		for (i = 0; i < gres_ptr->topo_sock_cnt; i++) {
+			if (!gres_ptr->topo_sock_bitmap[i])
+				continue;
+			new_gres->topo_sock_bitmap[i] =
+				bit_copy(gres_ptr->topo_sock_bitmap[i]);
+		}
+	}
 
 	if (gres_ptr->type_cnt) {
 		new_gres->type_cnt       = gres_ptr->type_cnt;
@@ -2944,6 +3059,7 @@ extern List gres_plugin_node_state_dup(List gres_list)
 			if (gres_data) {
 				new_gres = xmalloc(sizeof(gres_state_t));
 				new_gres->plugin_id = gres_ptr->plugin_id;
+				new_gres->gres_id = i;
 				new_gres->gres_data = gres_data;
 				list_append(new_list, new_gres);
 			}
@@ -3849,6 +3965,7 @@ static gres_job_state_t *_get_next_job_gres(char *in_val, uint64_t *cnt,
 		type = NULL;	/* String moved above */
 		gres_ptr = xmalloc(sizeof(gres_state_t));
 		gres_ptr->plugin_id = gres_context[context_inx].plugin_id;
+		gres_ptr->gres_id = context_inx;
 		gres_ptr->gres_data = job_gres_data;
 		list_append(gres_list, gres_ptr);
 	}
@@ -4651,6 +4768,7 @@ extern List gres_plugin_job_state_extract(List gres_list, int node_index)
 		}
 		new_gres_state = xmalloc(sizeof(gres_state_t));
 		new_gres_state->plugin_id = gres_ptr->plugin_id;
+		new_gres_state->gres_id = gres_ptr->gres_id;
 		new_gres_state->gres_data = new_gres_data;
 		list_append(new_gres_list, new_gres_state);
 	}
@@ -4969,6 +5087,7 @@ extern int gres_plugin_job_state_unpack(List *gres_list, Buf buffer,
 		gres_job_ptr->gres_name = xstrdup(gres_context[i].gres_name);
 		gres_ptr = xmalloc(sizeof(gres_state_t));
 		gres_ptr->plugin_id = gres_context[i].plugin_id;
+		gres_ptr->gres_id = i;
 		gres_ptr->gres_data = gres_job_ptr;
 		gres_job_ptr = NULL;	/* nothing left to free on error */
 		list_append(*gres_list, gres_ptr);
@@ -5052,6 +5171,7 @@ static void _validate_gres_node_cores(gres_node_state_t *node_gres_ptr,
 					cores_ctld);
 		FREE_NULL_BITMAP(node_gres_ptr->topo_core_bitmap[i]);
 		node_gres_ptr->topo_core_bitmap[i] = new_core_bitmap;
+		_topo_sock_clear(node_gres_ptr);
 	}
 }
 
@@ -5369,7 +5489,7 @@ extern void gres_plugin_job_core_filter(List job_gres_list, List node_gres_list,
 					char *node_name)
 {
 	int i;
-	ListIterator  job_gres_iter, node_gres_iter;
+	ListIterator  job_gres_iter;
 	gres_state_t *job_gres_ptr, *node_gres_ptr;
 
 	if ((job_gres_list == NULL) || (core_bitmap == NULL))
@@ -5384,13 +5504,9 @@ extern void gres_plugin_job_core_filter(List job_gres_list, List node_gres_list,
 	slurm_mutex_lock(&gres_context_lock);
 	job_gres_iter = list_iterator_create(job_gres_list);
 	while ((job_gres_ptr = (gres_state_t *) list_next(job_gres_iter))) {
-		node_gres_iter = list_iterator_create(node_gres_list);
-		while ((node_gres_ptr = (gres_state_t *)
-				list_next(node_gres_iter))) {
-			if (job_gres_ptr->plugin_id == node_gres_ptr->plugin_id)
-				break;
-		}
-		list_iterator_destroy(node_gres_iter);
+		node_gres_ptr = _find_node_gres(node_gres_list,
+						job_gres_ptr->plugin_id,
+						job_gres_ptr->gres_id);
 		if (node_gres_ptr == NULL) {
 			/* node lack resources required by the job */
 			bit_nclear(core_bitmap, core_start_bit, core_end_bit);
@@ -5436,7 +5552,7 @@ extern uint32_t gres_plugin_job_test(List job_gres_list, List node_gres_list,
 {
 	int i;
 	uint32_t core_cnt, tmp_cnt;
-	ListIterator job_gres_iter,  node_gres_iter;
+	ListIterator job_gres_iter;
 	gres_state_t *job_gres_ptr, *node_gres_ptr;
 	bool topo_set = false;
 
@@ -5451,13 +5567,9 @@ extern uint32_t gres_plugin_job_test(List job_gres_list, List node_gres_list,
 	slurm_mutex_lock(&gres_context_lock);
 	job_gres_iter = list_iterator_create(job_gres_list);
 	while ((job_gres_ptr = (gres_state_t *) list_next(job_gres_iter))) {
-		node_gres_iter = list_iterator_create(node_gres_list);
-		while ((node_gres_ptr = (gres_state_t *)
-				list_next(node_gres_iter))) {
-			if (job_gres_ptr->plugin_id == node_gres_ptr->plugin_id)
-				break;
-		}
-		list_iterator_destroy(node_gres_iter);
+		node_gres_ptr = _find_node_gres(node_gres_list,
+						job_gres_ptr->plugin_id,
+						job_gres_ptr->gres_id);
 		if (node_gres_ptr == NULL) {
 			/* node lack resources required by the job */
 			core_cnt = 0;
@@ -5562,6 +5674,80 @@ extern char *gres_plugin_sock_str(List sock_gres_list, int sock_inx)
 	return gres_str;
 }
 
+/*
+ * Build a bitmap of the sockets with cores in topo_core_bitmap, considering
+ * only the first tot_cores cores of the node
+ */
+static bitstr_t *_topo_sock_build(bitstr_t *topo_core_bitmap,
+				  uint16_t sockets, uint16_t cores_per_sock,
+				  int tot_cores)
+{
+	bitstr_t *sock_bitmap = bit_alloc(sockets);
+	int s, first_core;
+
+	tot_cores = MIN(tot_cores, bit_size(topo_core_bitmap));
+	for (s = 0; s < sockets; s++) {
+		first_core = s * cores_per_sock;
+		if (first_core >= tot_cores)
+			break;	/* Off end of core bitmap */
+		if (bit_set_count_range(topo_core_bitmap, first_core,
+					MIN(first_core + cores_per_sock,
+					    tot_cores)))
+			bit_set(sock_bitmap, s);
+	}
+
+	return sock_bitmap;
+}
+
+/* Free a node's cached topo socket bitmaps, see _topo_sock_map() */
+static void _topo_sock_clear(gres_node_state_t *node_gres_ptr)
+{
+	int i;
+
+	if (!node_gres_ptr->topo_sock_bitmap)
+		return;
+	for (i = 0; i < node_gres_ptr->topo_sock_cnt; i++)
+		FREE_NULL_BITMAP(node_gres_ptr->topo_sock_bitmap[i]);
+	xfree(node_gres_ptr->topo_sock_bitmap);
+	node_gres_ptr->topo_sock_cnt = 0;
+}
+
+/*
+ * Return the sockets local to each of a node's topo records (NULL entry if
+ * the record is not constrained by core). The result is cached in the node's
+ * GRES state so that it is only rebuilt when the socket/core layout or the
+ * topo records change, rather than for every job tested against the node.
+ */
+static bitstr_t **_topo_sock_map(gres_node_state_t *node_gres_ptr,
+				 uint16_t sockets, uint16_t cores_per_sock)
+{
+	int i;
+
+	if (node_gres_ptr->topo_sock_bitmap &&
+	    (node_gres_ptr->topo_sock_cnt == node_gres_ptr->topo_cnt) &&
+	    (node_gres_ptr->topo_sock_sockets == sockets) &&
+	    (node_gres_ptr->topo_sock_cores == cores_per_sock))
+		return node_gres_ptr->topo_sock_bitmap;
+
+	_topo_sock_clear(node_gres_ptr);
+	node_gres_ptr->topo_sock_bitmap = xmalloc(sizeof(bitstr_t *) *
+						  node_gres_ptr->topo_cnt);
+	node_gres_ptr->topo_sock_cnt = node_gres_ptr->topo_cnt;
+	node_gres_ptr->topo_sock_sockets = sockets;
+	node_gres_ptr->topo_sock_cores = cores_per_sock;
+	for (i = 0; i < node_gres_ptr->topo_cnt; i++) {
+		if (!node_gres_ptr->topo_core_bitmap ||
+		    !node_gres_ptr->topo_core_bitmap[i])
+			continue;
+		node_gres_ptr->topo_sock_bitmap[i] =
+			_topo_sock_build(node_gres_ptr->topo_core_bitmap[i],
+					 sockets, cores_per_sock,
+					 sockets * cores_per_sock);
+	}
+
+	return node_gres_ptr->topo_sock_bitmap;
+}
+
 /*
  * Determine how many GRES of a given type can be used by this job on a
  * given node and return a structure with the details. Note that multiple
@@ -5578,16 +5764,27 @@ static sock_gres_t *_build_sock_gres_by_topo(gres_job_state_t *job_gres_ptr,
 				uint32_t main_plugin_id, uint32_t alt_plugin_id,
 				gres_node_state_t *alt_node_gres_ptr)
 {
-	int i, j, s, c, tot_cores;
+	int i, s, c, tot_cores;
 	sock_gres_t *sock_gres;
 	int64_t add_gres;
 	uint64_t avail_gres, min_gres = 1;
 	bool match = false;
+	bool *avail_cores_by_sock = NULL;
+	bitstr_t **topo_sock_map = NULL, *sock_bitmap, *tmp_bitmap;
 
 	sock_gres = xmalloc(sizeof(sock_gres_t));
 	sock_gres->sock_cnt = sockets;
 	sock_gres->bits_by_sock = xmalloc(sizeof(bitstr_t *) * sockets);
 	sock_gres->cnt_by_sock = xmalloc(sizeof(uint64_t) * sockets);
+	tot_cores = sockets * cores_per_sock;
+	if (core_bitmap) {
+		tot_cores = MIN(tot_cores, bit_size(core_bitmap));
+		if (enforce_binding) {
+			avail_cores_by_sock = _build_avail_cores_by_sock(
+						core_bitmap, sockets,
+						cores_per_sock);
+		}
+	}
 	for (i = 0; i < node_gres_ptr->topo_cnt; i++) {
 		if (job_gres_ptr->type_name &&
 		    (job_gres_ptr->type_id != node_gres_ptr->topo_type_id[i]))
@@ -5637,50 +5834,42 @@ static sock_gres_t *_build_sock_gres_by_topo(gres_job_state_t *job_gres_ptr,
 		}
 
 		/* Constrained by core */
-		tot_cores = sockets * cores_per_sock;
-		if (core_bitmap)
-			tot_cores = MIN(tot_cores, bit_size(core_bitmap));
-		if (node_gres_ptr->topo_core_bitmap[i]) {
-			tot_cores = MIN(tot_cores,
-					bit_size(node_gres_ptr->
-						 topo_core_bitmap[i]));
-		}
-		for (s = 0; ((s < sockets) && avail_gres); s++) {
-			if (enforce_binding && core_bitmap) {
-				for (c = 0; c < cores_per_sock; c++) {
-					j = (s * cores_per_sock) + c;
-					if (bit_test(core_bitmap, j))
-						break;
-				}
-				if (c >= cores_per_sock) {
-					/* No available cores on this socket */
-					continue;
-				}
+		if (tot_cores < (sockets * cores_per_sock)) {
+			/* Truncated core bitmap, can not use cached map */
+			tmp_bitmap = _topo_sock_build(
+					node_gres_ptr->topo_core_bitmap[i],
+					sockets, cores_per_sock, tot_cores);
+			sock_bitmap = tmp_bitmap;
+		} else {
+			if (!topo_sock_map) {
+				topo_sock_map = _topo_sock_map(node_gres_ptr,
+							       sockets,
+							       cores_per_sock);
 			}
-			for (c = 0; c < cores_per_sock; c++) {
-				j = (s * cores_per_sock) + c;
-				if (j >= tot_cores)
-					break;	/* Off end of core bitmap */
-				if (node_gres_ptr->topo_core_bitmap[i] &&
-				    !bit_test(node_gres_ptr->topo_core_bitmap[i],
-					      j))
-					continue;
-				if (!sock_gres->bits_by_sock[s]) {
-					sock_gres->bits_by_sock[s] =
-						bit_copy(node_gres_ptr->
-							 topo_gres_bitmap[i]);
-				} else {
-					bit_or(sock_gres->bits_by_sock[s],
-					       node_gres_ptr->topo_gres_bitmap[i]);
-				}
-				sock_gres->cnt_by_sock[s] += avail_gres;
-				sock_gres->total_cnt += avail_gres;
-				avail_gres = 0;
-				match = true;
-				break;
+			tmp_bitmap = NULL;
+			sock_bitmap = topo_sock_map[i];
+		}
+		for (s = 0; s < sockets; s++) {
+			if (!bit_test(sock_bitmap, s))
+				continue;	/* GRES not local to socket */
+			if (avail_cores_by_sock && !avail_cores_by_sock[s])
+				continue;	/* No available cores on socket */
+			if (!sock_gres->bits_by_sock[s]) {
+				sock_gres->bits_by_sock[s] =
+					bit_copy(node_gres_ptr->
+						 topo_gres_bitmap[i]);
+			} else {
+				bit_or(sock_gres->bits_by_sock[s],
+				       node_gres_ptr->topo_gres_bitmap[i]);
 			}
+			sock_gres->cnt_by_sock[s] += avail_gres;
+			sock_gres->total_cnt += avail_gres;
+			match = true;
+			break;
 		}
+		FREE_NULL_BITMAP(tmp_bitmap);
 	}
+	xfree(avail_cores_by_sock);
 
 	/* Process per-GRES limits */
 	if (match && job_gres_ptr->gres_per_socket) {
@@ -5980,7 +6169,7 @@ extern List gres_plugin_job_test2(List job_gres_list, List node_gres_list,
 				  bitstr_t **req_sock_map)
 {
 	List sock_gres_list = NULL;
-	ListIterator job_gres_iter,  node_gres_iter;
+	ListIterator job_gres_iter;
 	gres_state_t *job_gres_ptr, *node_gres_ptr;
 	gres_job_state_t  *job_data_ptr;
 	gres_node_state_t *node_data_ptr;
@@ -5997,13 +6186,9 @@ extern List gres_plugin_job_test2(List job_gres_list, List node_gres_list,
 	job_gres_iter = list_iterator_create(job_gres_list);
 	while ((job_gres_ptr = (gres_state_t *) list_next(job_gres_iter))) {
 		sock_gres_t *sock_gres = NULL;
-		node_gres_iter = list_iterator_create(node_gres_list);
-		while ((node_gres_ptr = (gres_state_t *)
-				list_next(node_gres_iter))) {
-			if (job_gres_ptr->plugin_id == node_gres_ptr->plugin_id)
-				break;
-		}
-		list_iterator_destroy(node_gres_iter);
+		node_gres_ptr = _find_node_gres(node_gres_list,
+						job_gres_ptr->plugin_id,
+						job_gres_ptr->gres_id);
 		if (node_gres_ptr == NULL) {
 			/* node lack GRES of type required by the job */
 			FREE_NULL_LIST(sock_gres_list);
@@ -6029,15 +6214,9 @@ extern List gres_plugin_job_test2(List job_gres_list, List node_gres_list,
 					alt_plugin_id = gpu_plugin_id;
 			}
 			if (alt_plugin_id) {
-				node_gres_iter =
-					list_iterator_create(node_gres_list);
-				while ((node_gres_ptr = (gres_state_t *)
-						list_next(node_gres_iter))) {
-					if (node_gres_ptr->plugin_id ==
-					    alt_plugin_id)
-						break;
-				}
-				list_iterator_destroy(node_gres_iter);
+				node_gres_ptr = _find_node_gres(node_gres_list,
+						alt_plugin_id,
+						_gres_id(alt_plugin_id));
 			}
 			if (alt_plugin_id && node_gres_ptr) {
 				alt_node_data_ptr = (gres_node_state_t *)
@@ -8523,6 +8702,7 @@ static int _job_alloc(void *job_gres_data, void *node_gres_data, int node_cnt,
 			 * Need to add node topo arrays for slurmctld restart
 			 * and job state recovery (with GRES counts per topo)
 			 */
+			_topo_sock_clear(node_gres_ptr);
 			node_gres_ptr->topo_cnt =
 			    bit_size(job_gres_ptr->gres_bit_alloc[node_offset]);
 			node_gres_ptr->topo_core_bitmap =
@@ -8648,7 +8828,7 @@ extern int gres_plugin_job_alloc(List job_gres_list, List node_gres_list,
 				 bitstr_t *core_bitmap)
 {
 	int i, rc, rc2;
-	ListIterator job_gres_iter,  node_gres_iter;
+	ListIterator job_gres_iter;
 	gres_state_t *job_gres_ptr, *node_gres_ptr;
 
 	if (job_gres_list == NULL)
@@ -8677,13 +8857,9 @@ extern int gres_plugin_job_alloc(List job_gres_list, List node_gres_list,
 			continue;
 		}
 
-		node_gres_iter = list_iterator_create(node_gres_list);
-		while ((node_gres_ptr = (gres_state_t *)
-				list_next(node_gres_iter))) {
-			if (job_gres_ptr->plugin_id == node_gres_ptr->plugin_id)
-				break;
-		}
-		list_iterator_destroy(node_gres_iter);
+		node_gres_ptr = _find_node_gres(node_gres_list,
+						job_gres_ptr->plugin_id,
+						job_gres_ptr->gres_id);
 		if (node_gres_ptr == NULL) {
 			error("%s: job %u allocated gres/%s on node %s lacking that gres",
 			      __func__, job_id, gres_context[i].gres_name,
@@ -8928,7 +9104,7 @@ extern int gres_plugin_job_dealloc(List job_gres_list, List node_gres_list,
 				   char *node_name, bool old_job)
 {
 	int i, rc, rc2;
-	ListIterator job_gres_iter,  node_gres_iter;
+	ListIterator job_gres_iter;
 	gres_state_t *job_gres_ptr, *node_gres_ptr;
 	char *gres_name = NULL;
 
@@ -8959,13 +9135,9 @@ extern int gres_plugin_job_dealloc(List job_gres_list, List node_gres_list,
 		} else
 			gres_name = gres_context[i].gres_name;
 
-		node_gres_iter = list_iterator_create(node_gres_list);
-		while ((node_gres_ptr = (gres_state_t *)
-				list_next(node_gres_iter))) {
-			if (job_gres_ptr->plugin_id == node_gres_ptr->plugin_id)
-				break;
-		}
-		list_iterator_destroy(node_gres_iter);
+		node_gres_ptr = _find_node_gres(node_gres_list,
+						job_gres_ptr->plugin_id,
+						job_gres_ptr->gres_id);
 		if (node_gres_ptr == NULL) {
 			error("%s: node %s lacks gres/%s for job %u", __func__,
 			      node_name, gres_name , job_id);
@@ -9125,6 +9297,7 @@ step2:	if (!from_job_gres_list)
 			gres_ptr2 = xmalloc(sizeof(gres_state_t));
 			gres_job_ptr2 = xmalloc(sizeof(gres_job_state_t));
 			gres_ptr2->plugin_id = gres_ptr->plugin_id;
+			gres_ptr2->gres_id = gres_ptr->gres_id;
 			gres_ptr2->gres_data = gres_job_ptr2;
 			gres_job_ptr2->gres_name =
 					xstrdup(gres_job_ptr->gres_name);
@@ -9737,6 +9910,7 @@ static gres_step_state_t *_get_next_step_gres(char *in_val, uint64_t *cnt,
 		type = NULL;	/* String moved above */
 		gres_ptr = xmalloc(sizeof(gres_state_t));
 		gres_ptr->plugin_id = gres_context[context_inx].plugin_id;
+		gres_ptr->gres_id = context_inx;
 		gres_ptr->gres_data = step_gres_data;
 		list_append(gres_list, gres_ptr);
 	}
@@ -10056,6 +10230,7 @@ List gres_plugin_step_state_extract(List gres_list, int node_index)
 		}
 		new_gres_state = xmalloc(sizeof(gres_state_t));
 		new_gres_state->plugin_id = gres_ptr->plugin_id;
+		new_gres_state->gres_id = gres_ptr->gres_id;
 		new_gres_state->gres_data = new_gres_data;
 		list_append(new_gres_list, new_gres_state);
 	}
@@ -10364,6 +10539,7 @@ extern int gres_plugin_step_state_unpack(List *gres_list, Buf buffer,
 		}
 		gres_ptr = xmalloc(sizeof(gres_state_t));
 		gres_ptr->plugin_id = gres_context[i].plugin_id;
+		gres_ptr->gres_id = i;
 		gres_ptr->gres_data = gres_step_ptr;
 		gres_step_ptr = NULL;
 		list_append(*gres_list, gres_ptr);
@@ -151,6 +151,16 @@ typedef struct gres_node_state {
 	uint32_t *topo_type_id;		/* GRES type (e.g. model ID) */
 	char **topo_type_name;		/* GRES type (e.g. model name) */
 
+	/*
+	 * Sockets with cores local to each topo record, built on demand from
+	 * topo_core_bitmap for a given socket/core layout and cleared when
+	 * topo_core_bitmap changes. See _topo_sock_map() in gres.c.
+	 */
+	bitstr_t **topo_sock_bitmap;
+	uint16_t topo_sock_cnt;		/* Size of topo_sock_bitmap */
+	uint16_t topo_sock_sockets;	/* Socket count used to build it */
+	uint16_t topo_sock_cores;	/* Cores per socket used to build it */
+
 	/*
 	 * GRES type specific information (if gres.conf contains type option)
 	 *
@@ -247,6 +247,16 @@ struct hostlist {
 /* a hostset is a wrapper around a hostlist */
 struct hostset {
 	hostlist_t hl;
+
+	/* number of hosts in the ranges before each range of hl,
+	 * used by hostset_find() */
+	int *hcount;
+
+	/* allocated size of hcount */
+	int hcount_size;
+
+	/* hl->nhosts when hcount was built, -1 if hcount is stale */
+	int hcount_nhosts;
 };
 
 struct hostlist_iterator {
@@ -3537,6 +3547,9 @@ hostset_t hostset_create(const char *hostlist)
 		out_of_memory("hostset_create");
 		return NULL;
 	}
+	new->hcount = NULL;
+	new->hcount_size = 0;
+	new->hcount_nhosts = -1;
 
 	if (!(new->hl = hostlist_create(hostlist))) {
 		free(new);
@@ -3555,6 +3568,9 @@ hostset_t hostset_copy(const hostset_t set)
 
 	if (!(new->hl = hostlist_copy(set->hl)))
 		goto error2;
+	new->hcount = NULL;
+	new->hcount_size = 0;
+	new->hcount_nhosts = -1;
 
 	return new;
 error2:
@@ -3569,9 +3585,51 @@ void hostset_destroy(hostset_t set)
 	if (set == NULL)
 		return;
 	hostlist_destroy(set->hl);
+	free(set->hcount);
 	free(set);
 }
 
+/* mark the host counts of a hostset stale after hosts are added
+ * Assumes that the set->hl lock is already held
+ */
+static void _hostset_hcount_stale(hostset_t set)
+{
+	set->hcount_nhosts = -1;
+}
+
+/* return the number of hosts in the ranges of a hostset before each
+ * range, rebuilding the counts if the ranges changed since last built.
+ * Other than hostset_insert(), every change to a hostset only removes
+ * hosts, so those changes are caught by the change in hl->nhosts.
+ * Assumes that the set->hl lock is already held
+ */
+static int *_hostset_hcount(hostset_t set)
+{
+	hostlist_t hl = set->hl;
+	int i, n = 0;
+
+	if (set->hcount_nhosts == hl->nhosts)
+		return set->hcount;
+
+	if (set->hcount_size < hl->nranges) {
+		int *hcount = realloc(set->hcount,
+				      hl->size * sizeof(int));
+		if (!hcount) {
+			out_of_memory("hostset hcount");
+			return NULL;
+		}
+		set->hcount = hcount;
+		set->hcount_size = hl->size;
+	}
+	for (i = 0; i < hl->nranges; i++) {
+		set->hcount[i] = n;
+		n += hostrange_count(hl->hr[i]);
+	}
+	set->hcount_nhosts = hl->nhosts;
+
+	return set->hcount;
+}
+
 /* inserts a single range object into a hostset
  * Assumes that the set->hl lock is already held
  * Updates hl->nhosts
@@ -3637,6 +3695,7 @@ int hostset_insert(hostset_t set, const char *hosts)
 
 	hostlist_uniq(hl);
 	LOCK_HOSTLIST(set->hl);
+	_hostset_hcount_stale(set);
 	for (i = 0; i < hl->nranges; i++)
 		n += hostset_insert_range(set, hl->hr[i]);
 	UNLOCK_HOSTLIST(set->hl);
@@ -3645,7 +3704,48 @@ int hostset_insert(hostset_t set, const char *hosts)
 }
 
 
-/* linear search through N ranges for hostname "host"
+/* binary search through the sorted ranges of a hostset for the range
+ * containing hostname hn, comparing prefixes and then lowest suffixes.
+ * Returns the index of that range, or -1 if not found this way. Hosts
+ * only matched by hostrange_hn_within() moving digits between prefix and
+ * suffix are not found, so callers must fall back to a linear search.
+ * Assumes that the set->hl lock is already held
+ */
+static int _hostset_bsearch(hostset_t set, hostname_t hn)
+{
+	hostlist_t hl = set->hl;
+	hostrange_t hr;
+	int lo = 0, hi = hl->nranges - 1, mid, cmp, found = -1;
+	int single = !hostname_suffix_is_valid(hn);
+
+	while (lo <= hi) {
+		mid = (lo + hi) / 2;
+		hr = hl->hr[mid];
+		cmp = strnatcmp(hr->prefix, hn->prefix);
+		if (cmp == 0) {
+			/* singlehost ranges sort first within a prefix */
+			if (hr->singlehost != single)
+				cmp = hr->singlehost ? -1 : 1;
+			else if (single)
+				cmp = 0;
+			else
+				cmp = (hr->lo > hn->num) ? 1 : 0;
+		}
+		if (cmp <= 0) {
+			if (cmp == 0)
+				found = mid;
+			lo = mid + 1;
+		} else
+			hi = mid - 1;
+	}
+
+	if ((found == -1) || strcmp(hl->hr[found]->prefix, hn->prefix) ||
+	    !hostrange_hn_within(hl->hr[found], hn, 0))
+		return -1;
+	return found;
+}
+
+/* search through N ranges for hostname "host"
  * */
 static int hostset_find_host(hostset_t set, const char *host)
 {
@@ -3654,6 +3754,10 @@ static int hostset_find_host(hostset_t set, const char *host)
 	hostname_t hn;
 	LOCK_HOSTLIST(set->hl);
 	hn = hostname_create(host);
+	if (_hostset_bsearch(set, hn) >= 0) {
+		retval = 1;
+		goto done;
+	}
 	for (i = 0; i < set->hl->nranges; i++) {
 		/*
 		 * FIXME: THIS WILL NOT ALWAYS WORK CORRECTLY IF CALLED FROM A
@@ -3706,7 +3810,11 @@ int hostset_within(hostset_t set, const char *hosts)
 	nfound = 0;
 
 	while ((hostname = hostlist_pop(hl)) != NULL) {
-		nfound += hostset_find_host(set, hostname);
+		if (!hostset_find_host(set, hostname)) {
+			free(hostname);
+			break;
+		}
+		nfound++;
 		free(hostname);
 	}
 
@@ -3767,7 +3875,26 @@ char * hostset_nth(hostset_t set, int n)
 
 int hostset_find(hostset_t set, const char *hostname)
 {
-	return hostlist_find(set->hl, hostname);
+	int i, ret = -1, *hcount;
+	hostname_t hn;
+
+	if (!hostname)
+		return -1;
+
+	LOCK_HOSTLIST(set->hl);
+	hn = hostname_create(hostname);
+	if (((i = _hostset_bsearch(set, hn)) >= 0) &&
+	    (hcount = _hostset_hcount(set))) {
+		ret = hostname_suffix_is_valid(hn) ?
+		      hn->num - set->hl->hr[i]->lo : 0;
+		ret += hcount[i];
+	}
+	UNLOCK_HOSTLIST(set->hl);
+	hostname_destroy(hn);
+
+	if (ret == -1)
+		ret = hostlist_find(set->hl, hostname);
+	return ret;
 }
 
 #if TEST_MAIN
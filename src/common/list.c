@@ -108,6 +108,12 @@ strong_alias(list_install_fork_handlers, slurm_list_install_fork_handlers);
 #endif
 #define LIST_MAGIC 0xDEADBEEF
 
+/*
+ *  Number of free nodes and iterators moved at a time between a thread's
+ *  own cache and the global freelists (see list_cache_alloc()).
+ */
+#define LIST_CACHE 32
+
 
 /****************
  *  Data Types  *
@@ -142,6 +148,11 @@ struct xlist {
 
 typedef struct listNode * ListNode;
 
+struct listCache {
+	void                 *head;         /* thread's freelist of objects      */
+	int                   count;        /* number of objects in freelist     */
+};
+
 
 /****************
  *  Prototypes  *
@@ -156,7 +167,14 @@ static void list_node_free (ListNode p);
 static ListIterator list_iterator_alloc (void);
 static void list_iterator_free (ListIterator i);
 static void * list_alloc_aux (int size, void *pfreelist);
+static void * _list_alloc_aux_locked (int size, void *pfreelist);
 static void list_free_aux (void *x, void *pfreelist);
+#ifndef MEMORY_LEAK_DEBUG
+static void * list_cache_alloc (struct listCache *cache, int size,
+				void *pfreelist);
+static void list_cache_free (struct listCache *cache, void *x,
+			     void *pfreelist);
+#endif
 static void *_list_pop_locked(List l);
 static void *_list_append_locked(List l, void *x);
 
@@ -174,6 +192,19 @@ static ListIterator list_free_iterators = NULL;
 
 static pthread_mutex_t list_free_lock = PTHREAD_MUTEX_INITIALIZER;
 
+#ifndef MEMORY_LEAK_DEBUG
+/*
+ *  Nodes and iterators are created and destroyed by every list operation,
+ *  so each thread keeps its own cache of them and only takes list_free_lock
+ *  to move LIST_CACHE objects at a time to or from the global freelists.
+ *  A thread's caches are returned to the global freelists when it exits.
+ */
+static __thread struct listCache list_cache_nodes = { NULL, 0 };
+static __thread struct listCache list_cache_iterators = { NULL, 0 };
+static pthread_key_t list_cache_key;
+static pthread_once_t list_cache_once = PTHREAD_ONCE_INIT;
+#endif
+
 /***************
  *  Functions  *
  ***************/
@@ -877,7 +908,12 @@ list_free (List l)
 static ListNode
 list_node_alloc (void)
 {
+#ifdef MEMORY_LEAK_DEBUG
 	return(list_alloc_aux(sizeof(struct listNode), &list_free_nodes));
+#else
+	return(list_cache_alloc(&list_cache_nodes, sizeof(struct listNode),
+				&list_free_nodes));
+#endif
 }
 
 /* list_node_free()
@@ -885,7 +921,11 @@ list_node_alloc (void)
 static void
 list_node_free (ListNode p)
 {
+#ifdef MEMORY_LEAK_DEBUG
 	list_free_aux(p, &list_free_nodes);
+#else
+	list_cache_free(&list_cache_nodes, p, &list_free_nodes);
+#endif
 }
 
 /* list_iterator_alloc()
@@ -893,7 +933,13 @@ list_node_free (ListNode p)
 static ListIterator
 list_iterator_alloc (void)
 {
+#ifdef MEMORY_LEAK_DEBUG
 	return(list_alloc_aux(sizeof(struct listIterator), &list_free_iterators));
+#else
+	return(list_cache_alloc(&list_cache_iterators,
+				sizeof(struct listIterator),
+				&list_free_iterators));
+#endif
 }
 
 /* list_iterator_free()
@@ -901,28 +947,24 @@ list_iterator_alloc (void)
 static void
 list_iterator_free (ListIterator i)
 {
+#ifdef MEMORY_LEAK_DEBUG
 	list_free_aux(i, &list_free_iterators);
+#else
+	list_cache_free(&list_cache_iterators, i, &list_free_iterators);
+#endif
 }
 
-/* list_alloc_aux()
+/* _list_alloc_aux_locked()
+ *
+ * Same as list_alloc_aux(), assuming list_free_lock is already locked.
  */
 static void *
-list_alloc_aux (int size, void *pfreelist)
+_list_alloc_aux_locked (int size, void *pfreelist)
 {
-/*  Allocates an object of [size] bytes from the freelist [*pfreelist].
- *  Memory is added to the freelist in chunks of size LIST_ALLOC.
- *  Returns a ptr to the object, or NULL if the memory request fails.
- */
 	void **px;
 	void **pfree = pfreelist;
 	void **plast;
 
-	assert(sizeof(char) == 1);
-	assert(size >= sizeof(void *));
-	assert(pfreelist != NULL);
-	assert(LIST_ALLOC > 0);
-	slurm_mutex_lock(&list_free_lock);
-
 	if (!*pfree) {
 		if ((*pfree = xmalloc(LIST_ALLOC * size))) {
 			px = *pfree;
@@ -936,6 +978,27 @@ list_alloc_aux (int size, void *pfreelist)
 		*pfree = *px;
 	else
 		errno = ENOMEM;
+
+	return px;
+}
+
+/* list_alloc_aux()
+ */
+static void *
+list_alloc_aux (int size, void *pfreelist)
+{
+/*  Allocates an object of [size] bytes from the freelist [*pfreelist].
+ *  Memory is added to the freelist in chunks of size LIST_ALLOC.
+ *  Returns a ptr to the object, or NULL if the memory request fails.
+ */
+	void *px;
+
+	assert(sizeof(char) == 1);
+	assert(size >= sizeof(void *));
+	assert(pfreelist != NULL);
+	assert(LIST_ALLOC > 0);
+	slurm_mutex_lock(&list_free_lock);
+	px = _list_alloc_aux_locked(size, pfreelist);
 	slurm_mutex_unlock(&list_free_lock);
 
 	return px;
@@ -965,6 +1028,114 @@ list_free_aux (void *x, void *pfreelist)
 #endif
 }
 
+#ifndef MEMORY_LEAK_DEBUG
+/* _list_cache_drain()
+ *
+ * Return [cnt] objects from the thread's [cache] to the freelist [*pfreelist].
+ */
+static void
+_list_cache_drain (struct listCache *cache, int cnt, void *pfreelist)
+{
+	void **px;
+	void **pfree = pfreelist;
+
+	slurm_mutex_lock(&list_free_lock);
+	while ((cnt-- > 0) && (px = cache->head)) {
+		cache->head = *px;
+		cache->count--;
+		*px = *pfree;
+		*pfree = px;
+	}
+	slurm_mutex_unlock(&list_free_lock);
+}
+
+/* _list_cache_destroy()
+ *
+ * Thread exit handler, return the thread's caches to the global freelists.
+ */
+static void
+_list_cache_destroy (void *arg)
+{
+	_list_cache_drain(&list_cache_nodes, list_cache_nodes.count,
+			  &list_free_nodes);
+	_list_cache_drain(&list_cache_iterators, list_cache_iterators.count,
+			  &list_free_iterators);
+}
+
+static void
+_list_cache_key_create (void)
+{
+	if (pthread_key_create(&list_cache_key, _list_cache_destroy))
+		fatal("cannot create list cache key");
+}
+
+/* _list_cache_register()
+ *
+ * Make sure the thread's caches are drained when the thread exits. Called
+ * whenever the thread's [cache] is empty, before objects are added to it.
+ */
+static void
+_list_cache_register (struct listCache *cache)
+{
+	pthread_once(&list_cache_once, _list_cache_key_create);
+	if (!pthread_getspecific(list_cache_key))
+		pthread_setspecific(list_cache_key, cache);
+}
+
+/* list_cache_alloc()
+ */
+static void *
+list_cache_alloc (struct listCache *cache, int size, void *pfreelist)
+{
+/*  Allocates an object of [size] bytes from the thread's [cache], refilling
+ *  it with LIST_CACHE objects from the freelist [*pfreelist] when empty.
+ *  Returns a ptr to the object, or NULL if the memory request fails.
+ */
+	void **px;
+
+	if (!cache->head) {
+		_list_cache_register(cache);
+
+		slurm_mutex_lock(&list_free_lock);
+		while ((cache->count < LIST_CACHE) &&
+		       (px = _list_alloc_aux_locked(size, pfreelist))) {
+			*px = cache->head;
+			cache->head = px;
+			cache->count++;
+		}
+		slurm_mutex_unlock(&list_free_lock);
+	}
+
+	if ((px = cache->head)) {
+		cache->head = *px;
+		cache->count--;
+	} else
+		errno = ENOMEM;
+
+	return px;
+}
+
+/* list_cache_free()
+ */
+static void
+list_cache_free (struct listCache *cache, void *x, void *pfreelist)
+{
+/*  Frees the object [x], returning it to the thread's [cache]. Once the
+ *  cache holds 2 * LIST_CACHE objects, LIST_CACHE of them are returned to
+ *  the freelist [*pfreelist].
+ */
+	void **px = x;
+
+	assert(x != NULL);
+	if (!cache->head)
+		_list_cache_register(cache);
+	*px = cache->head;
+	cache->head = px;
+	if (++cache->count >= (2 * LIST_CACHE))
+		_list_cache_drain(cache, LIST_CACHE, pfreelist);
+}
+#endif
+
 static void
 list_reinit_mutexes (void)
 {
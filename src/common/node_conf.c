@@ -838,6 +838,7 @@ extern int node_name2bitmap (char *node_names, bool best_effort,
 	char *this_node_name;
 	bitstr_t *my_bitmap;
 	hostlist_t host_list;
+	hostlist_iterator_t hi;
 
 	my_bitmap = (bitstr_t *) bit_alloc (node_record_count);
 	*bitmap = my_bitmap;
@@ -855,7 +856,12 @@ extern int node_name2bitmap (char *node_names, bool best_effort,
 		return rc;
 	}
 
-	while ( (this_node_name = hostlist_shift (host_list)) ) {
+	/*
+	 * Iterate rather than shift names off the list, as removing each
+	 * emptied range moves all of those after it
+	 */
+	hi = hostlist_iterator_create(host_list);
+	while ((this_node_name = hostlist_next(hi))) {
 		struct node_record *node_ptr;
 		node_ptr = _find_node_record(this_node_name, best_effort, true);
 		if (node_ptr) {
@@ -869,6 +875,7 @@ extern int node_name2bitmap (char *node_names, bool best_effort,
 		}
 		free (this_node_name);
 	}
+	hostlist_iterator_destroy(hi);
 	hostlist_destroy (host_list);
 
 	return rc;
@@ -41,6 +41,8 @@
 
 #define _GNU_SOURCE
 
+#include "config.h"
+
 #include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
@@ -52,6 +54,10 @@
 #include <sys/types.h>
 #include <time.h>
 
+#if HAVE_LZ4
+# include <lz4.h>
+#endif
+
 #include "slurm/slurm_errno.h"
 #include "slurm/slurm.h"
 
@@ -75,6 +81,7 @@ strong_alias(create_mmap_buf,	slurm_create_mmap_buf);
 strong_alias(free_buf,		slurm_free_buf);
 strong_alias(grow_buf,		slurm_grow_buf);
 strong_alias(init_buf,		slurm_init_buf);
+strong_alias(try_grow_buf_remaining,	slurm_try_grow_buf_remaining);
 strong_alias(xfer_buf_data,	slurm_xfer_buf_data);
 strong_alias(pack_time,		slurm_pack_time);
 strong_alias(unpack_time,	slurm_unpack_time);
@@ -162,6 +169,13 @@ Buf create_mmap_buf(char *file)
 		return NULL;
 	}
 
+	/*
+	 * Callers unpack the file front to back right away, so start read
+	 * ahead of all of it now rather than faulting in one page at a time.
+	 */
+	(void) posix_madvise(data, f_stat.st_size, POSIX_MADV_WILLNEED);
+	(void) posix_madvise(data, f_stat.st_size, POSIX_MADV_SEQUENTIAL);
+
 	my_buf = xmalloc_nz(sizeof(struct slurm_buf));
 	my_buf->magic = BUF_MAGIC;
 	my_buf->size = f_stat.st_size;
@@ -189,6 +203,49 @@ void free_buf(Buf my_buf)
 	xfree(my_buf);
 }
 
+/*
+ * Make room for at least "size" more bytes after the current offset. The
+ * buffer grows by at least half of its current size each time, so packing
+ * a large message reallocs a logarithmic rather than linear number of times.
+ * RET SLURM_SUCCESS or SLURM_ERROR if MAX_BUF_SIZE would be exceeded
+ */
+static inline int _grow_buf_remaining(Buf buffer, uint32_t size,
+				      const char *caller)
+{
+	uint64_t need, new_size;
+
+	if (remaining_buf(buffer) >= size)
+		return SLURM_SUCCESS;
+
+	if (buffer->mmaped)
+		fatal_abort("attempt to grow mmap()'d buffer not supported");
+
+	need = (uint64_t) buffer->processed + size;
+	if (need > MAX_BUF_SIZE) {
+		error("%s: Buffer size limit exceeded (%"PRIu64" > %u)",
+		      caller, need, MAX_BUF_SIZE);
+		return SLURM_ERROR;
+	}
+	new_size = MAX(need + BUF_SIZE,
+		       (uint64_t) buffer->size + (buffer->size / 2));
+	new_size = MIN(new_size, MAX_BUF_SIZE);
+
+	buffer->size = new_size;
+	xrealloc_nz(buffer->head, buffer->size);
+	return SLURM_SUCCESS;
+}
+
+/*
+ * try_grow_buf_remaining - reserve room for at least "size" more bytes
+ *	after the current offset, for packers that know roughly how much
+ *	they are about to pack
+ * RET SLURM_SUCCESS or SLURM_ERROR if MAX_BUF_SIZE would be exceeded
+ */
+extern int try_grow_buf_remaining(Buf buffer, uint32_t size)
+{
+	return _grow_buf_remaining(buffer, size, __func__);
+}
+
 /* Grow a buffer by the specified amount */
 void grow_buf (Buf buffer, uint32_t size)
 {
@@ -241,6 +298,99 @@ void *xfer_buf_data(Buf my_buf)
 	return data_ptr;
 }
 
+/* lz4_buf_enabled - return true if buffers can be LZ4 (un)compressed */
+bool lz4_buf_enabled(void)
+{
+#if HAVE_LZ4
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+ * lz4_compress_buf - LZ4 compress "size" bytes of "data" into a new buffer
+ *	holding the uncompressed size followed by the compressed data
+ * RET the new buffer, offset at its end, or NULL if LZ4 is not available or
+ *	the data does not get any smaller. Must be freed with free_buf().
+ */
+Buf lz4_compress_buf(char *data, uint32_t size)
+{
+#if HAVE_LZ4
+	Buf my_buf;
+	int bound, out_len;
+
+	if (!size || (size > LZ4_MAX_INPUT_SIZE))
+		return NULL;
+	bound = LZ4_compressBound(size);
+	if (!(my_buf = init_buf(sizeof(uint32_t) + bound)))
+		return NULL;
+	pack32(size, my_buf);
+	out_len = LZ4_compress_default(data, &my_buf->head[my_buf->processed],
+				       size, bound);
+	if ((out_len <= 0) ||
+	    ((my_buf->processed + out_len) >= size)) {
+		free_buf(my_buf);
+		return NULL;
+	}
+	my_buf->processed += out_len;
+	return my_buf;
+#else
+	return NULL;
+#endif
+}
+
+/*
+ * lz4_uncompress_buf - uncompress in place the data from the buffer's
+ *	current offset to its end, as made by lz4_compress_buf(). The data
+ *	before the offset is kept, the offset is left at the start of the
+ *	uncompressed data.
+ * RET SLURM_SUCCESS or SLURM_ERROR
+ */
+int lz4_uncompress_buf(Buf buffer)
+{
+#if HAVE_LZ4
+	uint32_t offset = buffer->processed, size;
+	int in_len, out_len;
+	char *head;
+
+	if (buffer->mmaped)
+		fatal_abort("attempt to grow mmap()'d buffer not supported");
+	if (unpack32(&size, buffer))
+		return SLURM_ERROR;
+	if (size > LZ4_MAX_INPUT_SIZE) {
+		error("%s: invalid uncompressed size %u", __func__, size);
+		return SLURM_ERROR;
+	}
+	if (((uint64_t) offset + size) > MAX_BUF_SIZE) {
+		error("%s: Buffer size limit exceeded (%"PRIu64" > %u)",
+		      __func__, (uint64_t) offset + size, MAX_BUF_SIZE);
+		return SLURM_ERROR;
+	}
+
+	in_len = remaining_buf(buffer);
+	head = xmalloc_nz(offset + size);
+	memcpy(head, buffer->head, offset);
+	out_len = LZ4_decompress_safe(&buffer->head[buffer->processed],
+				      &head[offset], in_len, size);
+	if (out_len != (int) size) {
+		error("%s: lz4 decompression error (%d != %u)",
+		      __func__, out_len, size);
+		xfree(head);
+		return SLURM_ERROR;
+	}
+
+	xfree(buffer->head);
+	buffer->head = head;
+	buffer->size = offset + size;
+	buffer->processed = offset;
+	return SLURM_SUCCESS;
+#else
+	error("%s: lz4 compression not supported", __func__);
+	return SLURM_ERROR;
+#endif
+}
+
 /*
  * Given a time_t in host byte order, promote it to int64_t, convert to
  * network byte order, store in buffer and adjust buffer acc'd'ngly
@@ -249,16 +399,8 @@ void pack_time(time_t val, Buf buffer)
 {
 	int64_t n64 = HTON_int64((int64_t) val);
 
-	if (remaining_buf(buffer) < sizeof(n64)) {
-		if ((buffer->size + BUF_SIZE) > MAX_BUF_SIZE) {
-			error("%s: Buffer size limit exceeded (%u > %u)",
-			      __func__, (buffer->size + BUF_SIZE),
-			      MAX_BUF_SIZE);
-			return;
-		}
-		buffer->size += BUF_SIZE;
-		xrealloc_nz(buffer->head, buffer->size);
-	}
+	if (_grow_buf_remaining(buffer, sizeof(n64), __func__))
+		return;
 
 	memcpy(&buffer->head[buffer->processed], &n64, sizeof(n64));
 	buffer->processed += sizeof(n64);
@@ -298,16 +440,8 @@ void 	packdouble(double val, Buf buffer)
 	 */
 	uval.d =  (val * FLOAT_MULT);
 	nl =  HTON_uint64(uval.u);
-	if (remaining_buf(buffer) < sizeof(nl)) {
-		if ((buffer->size + BUF_SIZE) > MAX_BUF_SIZE) {
-			error("%s: Buffer size limit exceeded (%u > %u)",
-			      __func__, (buffer->size + BUF_SIZE),
-			      MAX_BUF_SIZE);
-			return;
-		}
-		buffer->size += BUF_SIZE;
-		xrealloc_nz(buffer->head, buffer->size);
-	}
+	if (_grow_buf_remaining(buffer, sizeof(nl), __func__))
+		return;
 
 	memcpy(&buffer->head[buffer->processed], &nl, sizeof(nl));
 	buffer->processed += sizeof(nl);
@@ -424,16 +558,8 @@ void pack64(uint64_t val, Buf buffer)
 {
 	uint64_t nl =  HTON_uint64(val);
 
-	if (remaining_buf(buffer) < sizeof(nl)) {
-		if ((buffer->size + BUF_SIZE) > MAX_BUF_SIZE) {
-			error("%s: Buffer size limit exceeded (%u > %u)",
-			      __func__, (buffer->size + BUF_SIZE),
-			      MAX_BUF_SIZE);
-			return;
-		}
-		buffer->size += BUF_SIZE;
-		xrealloc_nz(buffer->head, buffer->size);
-	}
+	if (_grow_buf_remaining(buffer, sizeof(nl), __func__))
+		return;
 
 	memcpy(&buffer->head[buffer->processed], &nl, sizeof(nl));
 	buffer->processed += sizeof(nl);
@@ -463,16 +589,8 @@ void pack32(uint32_t val, Buf buffer)
 {
 	uint32_t nl = htonl(val);
 
-	if (remaining_buf(buffer) < sizeof(nl)) {
-		if ((buffer->size + BUF_SIZE) > MAX_BUF_SIZE) {
-			error("%s: Buffer size limit exceeded (%u > %u)",
-			      __func__, (buffer->size + BUF_SIZE),
-			      MAX_BUF_SIZE);
-			return;
-		}
-		buffer->size += BUF_SIZE;
-		xrealloc_nz(buffer->head, buffer->size);
-	}
+	if (_grow_buf_remaining(buffer, sizeof(nl), __func__))
+		return;
 
 	memcpy(&buffer->head[buffer->processed], &nl, sizeof(nl));
 	buffer->processed += sizeof(nl);
@@ -710,16 +828,8 @@ void pack16(uint16_t val, Buf buffer)
 {
 	uint16_t ns = htons(val);
 
-	if (remaining_buf(buffer) < sizeof(ns)) {
-		if ((buffer->size + BUF_SIZE) > MAX_BUF_SIZE) {
-			error("%s: Buffer size limit exceeded (%u > %u)",
-			      __func__, (buffer->size + BUF_SIZE),
-			      MAX_BUF_SIZE);
-			return;
-		}
-		buffer->size += BUF_SIZE;
-		xrealloc_nz(buffer->head, buffer->size);
-	}
+	if (_grow_buf_remaining(buffer, sizeof(ns), __func__))
+		return;
 
 	memcpy(&buffer->head[buffer->processed], &ns, sizeof(ns));
 	buffer->processed += sizeof(ns);
@@ -748,16 +858,8 @@ int unpack16(uint16_t * valp, Buf buffer)
  */
 void pack8(uint8_t val, Buf buffer)
 {
-	if (remaining_buf(buffer) < sizeof(uint8_t)) {
-		if ((buffer->size + BUF_SIZE) > MAX_BUF_SIZE) {
-			error("%s: Buffer size limit exceeded (%u > %u)",
-			      __func__, (buffer->size + BUF_SIZE),
-			      MAX_BUF_SIZE);
-			return;
-		}
-		buffer->size += BUF_SIZE;
-		xrealloc_nz(buffer->head, buffer->size);
-	}
+	if (_grow_buf_remaining(buffer, sizeof(uint8_t), __func__))
+		return;
 
 	memcpy(&buffer->head[buffer->processed], &val, sizeof(uint8_t));
 	buffer->processed += sizeof(uint8_t);
@@ -820,16 +922,8 @@ void packmem(char *valp, uint32_t size_val, Buf buffer)
 		      __func__, size_val, MAX_PACK_MEM_LEN);
 		return;
 	}
-	if (remaining_buf(buffer) < (sizeof(ns) + size_val)) {
-		if ((buffer->size + size_val + BUF_SIZE) > MAX_BUF_SIZE) {
-			error("%s: Buffer size limit exceeded (%u > %u)",
-			      __func__, (buffer->size + size_val + BUF_SIZE),
-			      MAX_BUF_SIZE);
-			return;
-		}
-		buffer->size += (size_val + BUF_SIZE);
-		xrealloc_nz(buffer->head, buffer->size);
-	}
+	if (_grow_buf_remaining(buffer, sizeof(ns) + size_val, __func__))
+		return;
 
 	memcpy(&buffer->head[buffer->processed], &ns, sizeof(ns));
 	buffer->processed += sizeof(ns);
@@ -1070,16 +1164,8 @@ void packstr_array(char **valp, uint32_t size_val, Buf buffer)
 	int i;
 	uint32_t ns = htonl(size_val);
 
-	if (remaining_buf(buffer) < sizeof(ns)) {
-		if ((buffer->size + BUF_SIZE) > MAX_BUF_SIZE) {
-			error("%s: Buffer size limit exceeded (%u > %u)",
-			      __func__, (buffer->size + BUF_SIZE),
-			      MAX_BUF_SIZE);
-			return;
-		}
-		buffer->size += BUF_SIZE;
-		xrealloc_nz(buffer->head, buffer->size);
-	}
+	if (_grow_buf_remaining(buffer, sizeof(ns), __func__))
+		return;
 
 	memcpy(&buffer->head[buffer->processed], &ns, sizeof(ns));
 	buffer->processed += sizeof(ns);
@@ -1137,16 +1223,8 @@ int unpackstr_array(char ***valp, uint32_t * size_valp, Buf buffer)
  */
 void packmem_array(char *valp, uint32_t size_val, Buf buffer)
 {
-	if (remaining_buf(buffer) < size_val) {
-		if ((buffer->size + size_val + BUF_SIZE) > MAX_BUF_SIZE) {
-			error("%s: Buffer size limit exceeded (%u > %u)",
-			      __func__, (buffer->size + size_val + BUF_SIZE),
-			      MAX_BUF_SIZE);
-			return;
-		}
-		buffer->size += (size_val + BUF_SIZE);
-		xrealloc_nz(buffer->head, buffer->size);
-	}
+	if (_grow_buf_remaining(buffer, size_val, __func__))
+		return;
 
 	memcpy(&buffer->head[buffer->processed], valp, size_val);
 	buffer->processed += size_val;
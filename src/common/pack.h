@@ -81,7 +81,11 @@ Buf	create_mmap_buf(char *file);
 void	free_buf(Buf my_buf);
 Buf	init_buf(uint32_t size);
 void    grow_buf (Buf my_buf, uint32_t size);
+int	try_grow_buf_remaining(Buf my_buf, uint32_t size);
 void	*xfer_buf_data(Buf my_buf);
+bool	lz4_buf_enabled(void);
+Buf	lz4_compress_buf(char *data, uint32_t size);
+int	lz4_uncompress_buf(Buf buffer);
 
 void	pack_time(time_t val, Buf buffer);
 int	unpack_time(time_t *valp, Buf buffer);
@@ -351,6 +355,19 @@ int	unpackmem_array(char *valp, uint32_t size_valp, Buf buffer);
 		goto unpack_error;		       		\
 } while (0)
 
+/*
+ * Unpack a string pointing into the buffer if "borrow" is set, in which case
+ * the buffer must outlive the string and the string must not be xfree()'d,
+ * otherwise into a newly xmalloc()'d copy
+ */
+#define safe_unpackstr_borrow(valp, size_valp, buf, borrow) do {	\
+	assert(sizeof(*size_valp) == sizeof(uint32_t));		\
+	assert(buf->magic == BUF_MAGIC);				\
+	if ((borrow) ? unpackstr_ptr(valp, size_valp, buf) :		\
+		       unpackstr_xmalloc_chooser(valp, size_valp, buf))	\
+		goto unpack_error;					\
+} while (0)
+
 #define safe_unpackstr_array(valp,size_valp,buf) do {	\
 	assert(sizeof(*size_valp) == sizeof(uint32_t)); \
 	assert(buf->magic == BUF_MAGIC);		\
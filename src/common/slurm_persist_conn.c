@@ -62,6 +62,12 @@
  */
 #define MAX_MSG_SIZE     (16*1024*1024)
 
+/*
+ *  Set in the length sent before a message on a PERSIST_FLAG_LZ4 connection
+ *  when the message is LZ4 compressed, see lz4_compress_buf().
+ */
+#define PERSIST_MSG_LZ4  0x80000000
+
 typedef struct {
 	void *arg;
 	slurm_persist_conn_t *conn;
@@ -192,13 +198,31 @@ static void _persist_free_msg_members(slurm_persist_conn_t *persist_conn,
 		slurm_free_msg_data(persist_msg->msg_type, persist_msg->data);
 }
 
+/*
+ * Replace an LZ4 compressed message read from a persistent connection with
+ * its uncompressed form
+ */
+static int _uncompress_msg(char **msg_char, uint32_t *msg_size)
+{
+	Buf buffer = create_buf(*msg_char, *msg_size);
+
+	if (lz4_uncompress_buf(buffer) ||
+	    (size_buf(buffer) > MAX_MSG_SIZE)) {
+		*msg_char = xfer_buf_data(buffer);
+		return SLURM_ERROR;
+	}
+	*msg_size = size_buf(buffer);
+	*msg_char = xfer_buf_data(buffer);
+	return SLURM_SUCCESS;
+}
+
 static int _process_service_connection(
 	slurm_persist_conn_t *persist_conn, void *arg)
 {
 	uint32_t nw_size = 0, msg_size = 0, uid = NO_VAL;
 	char *msg_char = NULL;
 	ssize_t msg_read = 0, offset = 0;
-	bool first = true, fini = false;
+	bool first = true, fini = false, lz4;
 	Buf buffer = NULL;
 	int rc = SLURM_SUCCESS;
 
@@ -224,6 +248,12 @@ static int _process_service_connection(
 			break;
 		}
 		msg_size = ntohl(nw_size);
+		lz4 = false;
+		if ((persist_conn->flags & PERSIST_FLAG_LZ4) &&
+		    (msg_size & PERSIST_MSG_LZ4)) {
+			msg_size &= ~PERSIST_MSG_LZ4;
+			lz4 = true;
+		}
 		if ((msg_size < 2) || (msg_size > MAX_MSG_SIZE)) {
 			error("Invalid msg_size (%u) from "
 			      "connection %d(%s) uid(%d)",
@@ -245,7 +275,12 @@ static int _process_service_connection(
 			}
 			offset += msg_read;
 		}
-		if (msg_size == offset) {
+		if ((msg_size == offset) && lz4 &&
+		    _uncompress_msg(&msg_char, &msg_size)) {
+			buffer = slurm_persist_make_rc_msg(
+				persist_conn, SLURM_ERROR, "Bad compression", 0);
+			fini = true;
+		} else if (msg_size == offset) {
 			persist_msg_t msg;
 
 			rc = slurm_persist_conn_process_msg(
@@ -577,6 +612,9 @@ extern int slurm_persist_conn_open(slurm_persist_conn_t *persist_conn)
 	if (persist_conn->flags & PERSIST_FLAG_DBD)
 		req_msg.flags |= SLURMDBD_CONNECTION;
 
+	/* The init response says whether the remote end takes LZ4 */
+	persist_conn->flags &= ~PERSIST_FLAG_LZ4;
+
 	memset(&req, 0, sizeof(persist_init_req_msg_t));
 	req.cluster_name = persist_conn->cluster_name;
 	req.persist_type = persist_conn->persist_type;
@@ -640,6 +678,13 @@ end_it:
 	return rc;
 }
 
+extern void slurm_persist_conn_set_lz4(slurm_persist_conn_t *persist_conn,
+				       uint16_t msg_flags)
+{
+	if ((msg_flags & SLURM_MSG_ACCEPT_LZ4) && lz4_buf_enabled())
+		persist_conn->flags |= PERSIST_FLAG_LZ4;
+}
+
 extern void slurm_persist_conn_close(slurm_persist_conn_t *persist_conn)
 {
 	if (!persist_conn)
@@ -809,22 +854,13 @@ extern int slurm_persist_conn_writeable(slurm_persist_conn_t *persist_conn)
 	return 0;
 }
 
-extern int slurm_persist_send_msg(
-	slurm_persist_conn_t *persist_conn, Buf buffer)
+static int _send_msg(slurm_persist_conn_t *persist_conn,
+		     char *msg, uint32_t msg_size, uint32_t size_flags)
 {
-	uint32_t msg_size, nw_size;
-	char *msg;
+	uint32_t nw_size;
 	ssize_t msg_wrote;
 	int rc, retry_cnt = 0;
 
-	xassert(persist_conn);
-
-	if (persist_conn->fd < 0)
-		return EAGAIN;
-
-	if (!buffer)
-		return SLURM_ERROR;
-
 	rc = slurm_persist_conn_writeable(persist_conn);
 	if (rc == -1) {
 	re_open:
@@ -844,13 +880,11 @@ extern int slurm_persist_send_msg(
 	if (rc < 1)
 		return EAGAIN;
 
-	msg_size = get_buf_offset(buffer);
-	nw_size = htonl(msg_size);
+	nw_size = htonl(msg_size | size_flags);
 	msg_wrote = write(persist_conn->fd, &nw_size, sizeof(nw_size));
 	if (msg_wrote != sizeof(nw_size))
 		return EAGAIN;
 
-	msg = get_buf_data(buffer);
 	while (msg_size > 0) {
 		rc = slurm_persist_conn_writeable(persist_conn);
 		if (rc == -1)
@@ -867,11 +901,50 @@ extern int slurm_persist_send_msg(
 	return SLURM_SUCCESS;
 }
 
+extern int slurm_persist_send_msg(
+	slurm_persist_conn_t *persist_conn, Buf buffer)
+{
+	uint32_t msg_size, size_flags = 0;
+	char *msg;
+	Buf zbuf = NULL;
+	int rc;
+
+	xassert(persist_conn);
+
+	if (persist_conn->fd < 0)
+		return EAGAIN;
+
+	if (!buffer)
+		return SLURM_ERROR;
+
+	msg_size = get_buf_offset(buffer);
+	msg = get_buf_data(buffer);
+
+	if ((persist_conn->flags & PERSIST_FLAG_LZ4) &&
+	    (msg_size >= SLURM_MSG_COMPRESS_MIN)) {
+		if ((zbuf = lz4_compress_buf(msg, msg_size))) {
+			msg_size = get_buf_offset(zbuf);
+			msg = get_buf_data(zbuf);
+			size_flags = PERSIST_MSG_LZ4;
+		} else if (msg_size & PERSIST_MSG_LZ4) {
+			error("%s: message of %u bytes is too large",
+			      __func__, msg_size);
+			return SLURM_ERROR;
+		}
+	}
+
+	rc = _send_msg(persist_conn, msg, msg_size, size_flags);
+	FREE_NULL_BUFFER(zbuf);
+
+	return rc;
+}
+
 extern Buf slurm_persist_recv_msg(slurm_persist_conn_t *persist_conn)
 {
 	uint32_t msg_size, nw_size;
 	char *msg;
 	ssize_t msg_read, offset;
+	bool lz4 = false;
 	Buf buffer;
 
 	xassert(persist_conn);
@@ -886,6 +959,11 @@ extern Buf slurm_persist_recv_msg(slurm_persist_conn_t *persist_conn)
 	if (msg_read != sizeof(nw_size))
 		goto endit;
 	msg_size = ntohl(nw_size);
+	if ((persist_conn->flags & PERSIST_FLAG_LZ4) &&
+	    (msg_size & PERSIST_MSG_LZ4)) {
+		msg_size &= ~PERSIST_MSG_LZ4;
+		lz4 = true;
+	}
 	/* We don't error check for an upper limit here
 	 * since size could possibly be massive */
 	if (msg_size < 2) {
@@ -916,6 +994,12 @@ extern Buf slurm_persist_recv_msg(slurm_persist_conn_t *persist_conn)
 	}
 
 	buffer = create_buf(msg, msg_size);
+	if (lz4 && lz4_uncompress_buf(buffer)) {
+		error("Persistent Conn: could not uncompress %u byte message",
+		      msg_size);
+		free_buf(buffer);
+		goto endit;
+	}
 	return buffer;
 
 endit:
@@ -1001,6 +1085,8 @@ extern int slurm_persist_msg_unpack(slurm_persist_conn_t *persist_conn,
 
 		persist_conn->auth_cred = msg->auth_cred;
 		msg->auth_cred = NULL;
+
+		slurm_persist_conn_set_lz4(persist_conn, msg->flags);
 	}
 
 	return rc;
@@ -44,6 +44,8 @@
 #define PERSIST_FLAG_RECONNECT      0x0002
 #define PERSIST_FLAG_ALREADY_INITED 0x0004
 #define PERSIST_FLAG_P_USER_CASE    0x0008
+#define PERSIST_FLAG_LZ4            0x0010 /* large messages may be LZ4
+						 * compressed both ways */
 
 typedef enum {
 	PERSIST_TYPE_NONE = 0,
@@ -143,6 +145,12 @@ extern int slurm_persist_conn_open_without_init(
  * Returns SLURM_SUCCESS on success or SLURM_ERROR on failure */
 extern int slurm_persist_conn_open(slurm_persist_conn_t *persist_conn);
 
+/* Turn on LZ4 compression of large messages on a persistent connection if
+ * both ends can do it.
+ * IN msg_flags - header flags of the REQUEST_PERSIST_INIT that opened it */
+extern void slurm_persist_conn_set_lz4(slurm_persist_conn_t *persist_conn,
+				       uint16_t msg_flags);
+
 /* Close the persistent connection don't free structure or members */
 extern void slurm_persist_conn_close(slurm_persist_conn_t *persist_conn);
 
@@ -98,6 +98,7 @@ static int message_timeout = -1;
 static char *_global_auth_key(void);
 static void  _remap_slurmctld_errno(void);
 static int   _unpack_msg_uid(Buf buffer, uint16_t protocol_version);
+static int   _uncompress_body(header_t *header, Buf buffer);
 static bool  _is_port_ok(int, uint16_t, bool);
 
 #if _DEBUG
@@ -3304,11 +3305,13 @@ extern int slurm_unpack_received_msg(slurm_msg_t *msg, int fd, Buf buffer)
 	 */
 	msg->protocol_version = header.version;
 	msg->msg_type = header.msg_type;
-	msg->flags = header.flags;
+	msg->flags = (header.flags & ~SLURM_MSG_BORROW_BUFFER) |
+		     (msg->flags & SLURM_MSG_BORROW_BUFFER);
 
 	msg->body_offset =  get_buf_offset(buffer);
 
 	if ((header.body_length > remaining_buf(buffer)) ||
+	    _uncompress_body(&header, buffer) ||
 	    (unpack_msg(msg, buffer) != SLURM_SUCCESS)) {
 		rc = ESLURM_PROTOCOL_INCOMPLETE_PACKET;
 		(void) g_slurm_auth_destroy(auth_cred);
@@ -3579,6 +3582,7 @@ List slurm_receive_msgs(int fd, int steps, int timeout)
 	msg.flags = header.flags;
 
 	if ((header.body_length > remaining_buf(buffer)) ||
+	    _uncompress_body(&header, buffer) ||
 	    (unpack_msg(&msg, buffer) != SLURM_SUCCESS)) {
 		(void) g_slurm_auth_destroy(auth_cred);
 		free_buf(buffer);
@@ -3620,6 +3624,20 @@ total_return:
 
 }
 
+/*
+ * Uncompress an LZ4 compressed message body in place, the header's
+ * body_length is updated to match
+ */
+static int _uncompress_body(header_t *header, Buf buffer)
+{
+	if (!(header->flags & SLURM_MSG_LZ4))
+		return SLURM_SUCCESS;
+	if (lz4_uncompress_buf(buffer))
+		return SLURM_ERROR;
+	header->body_length = remaining_buf(buffer);
+	return SLURM_SUCCESS;
+}
+
 /* try to determine the UID associated with a message with different
  * message header version, return -1 if we can't tell */
 static int _unpack_msg_uid(Buf buffer, uint16_t protocol_version)
@@ -3818,6 +3836,7 @@ int slurm_receive_msg_and_forward(int fd, slurm_addr_t *orig_addr,
 	}
 
 	if ( (header.body_length > remaining_buf(buffer)) ||
+	     _uncompress_body(&header, buffer) ||
 	     (unpack_msg(msg, buffer) != SLURM_SUCCESS) ) {
 		(void) g_slurm_auth_destroy(auth_cred);
 		free_buf(buffer);
@@ -3856,13 +3875,18 @@ total_return:
  *  and hdr into buffer
  */
 static void
-_pack_msg(slurm_msg_t *msg, header_t *hdr, Buf buffer)
+_pack_msg(slurm_msg_t *msg, header_t *hdr, Buf buffer, uint32_t body_size)
 {
 	unsigned int tmplen, msglen;
 
-	tmplen = get_buf_offset(buffer);
-	pack_msg(msg, buffer);
-	msglen = get_buf_offset(buffer) - tmplen;
+	if (body_size) {
+		/* body of this size is sent separately after the buffer */
+		msglen = body_size;
+	} else {
+		tmplen = get_buf_offset(buffer);
+		pack_msg(msg, buffer);
+		msglen = get_buf_offset(buffer) - tmplen;
+	}
 
 	/* update header with correct cred and msg lengths */
 	update_header(hdr, msglen);
@@ -3882,9 +3906,12 @@ int slurm_send_node_msg(int fd, slurm_msg_t * msg)
 {
 	header_t header;
 	Buf      buffer;
+	Buf      zbuf = NULL;
 	int      rc;
 	void *   auth_cred;
 	time_t   start_time = time(NULL);
+	char *   body = NULL;
+	uint32_t body_size = 0;
 
 	if (msg->conn) {
 		persist_msg_t persist_msg;
@@ -3982,9 +4009,26 @@ int slurm_send_node_msg(int fd, slurm_msg_t * msg)
 	}
 
 	/*
-	 * Pack message into buffer
+	 * Pack message into buffer. Bodies that are already packed, which
+	 * can be hundreds of megabytes for job or node information, are not
+	 * copied into the buffer but sent straight after it.
 	 */
-	_pack_msg(msg, &header, buffer);
+	if (msg->data_size && pack_msg_prepacked(msg)) {
+		body = msg->data;
+		body_size = msg->data_size;
+		/*
+		 * These are the large responses, compress them if the peer
+		 * told us in its request that it can take that.
+		 */
+		if ((msg->flags & SLURM_MSG_ACCEPT_LZ4) &&
+		    (body_size >= SLURM_MSG_COMPRESS_MIN) &&
+		    (zbuf = lz4_compress_buf(body, body_size))) {
+			header.flags |= SLURM_MSG_LZ4;
+			body = get_buf_data(zbuf);
+			body_size = get_buf_offset(zbuf);
+		}
+	}
+	_pack_msg(msg, &header, buffer, body_size);
 
 #if	_DEBUG
 	_print_data (get_buf_data(buffer),get_buf_offset(buffer));
@@ -3992,8 +4036,13 @@ int slurm_send_node_msg(int fd, slurm_msg_t * msg)
 	/*
 	 * Send message
 	 */
-	rc = slurm_msg_sendto(fd, get_buf_data(buffer),
-			      get_buf_offset(buffer));
+	if (body_size)
+		rc = slurm_msg_sendto_vec(fd, get_buf_data(buffer),
+					  get_buf_offset(buffer),
+					  body, body_size);
+	else
+		rc = slurm_msg_sendto(fd, get_buf_data(buffer),
+				      get_buf_offset(buffer));
 
 	if ((rc < 0) && (errno == ENOTCONN)) {
 		debug3("slurm_msg_sendto: peer has disappeared for msg_type=%u",
@@ -4016,6 +4065,7 @@ int slurm_send_node_msg(int fd, slurm_msg_t * msg)
 			      msg->msg_type);
 	}
 
+	FREE_NULL_BUFFER(zbuf);
 	free_buf(buffer);
 	return rc;
 }
@@ -4365,6 +4415,7 @@ extern int slurm_send_recv_msg(int fd, slurm_msg_t *req,
 {
 	int rc = -1;
 	slurm_msg_t_init(resp);
+	resp->flags |= (req->flags & SLURM_MSG_BORROW_BUFFER);
 
 	/* If we are using a persistent connection make sure it is the one we
 	 * actually want.  This should be the correct one already, but just make
@@ -105,6 +105,18 @@
 #define SLURMDBD_CONNECTION     0x0002
 #define SLURM_MSG_KEEP_BUFFER   0x0004
 #define SLURM_DROP_PRIV		0x0008
+/*
+ * Local only, never sent: the unpacked response may take over the received
+ * buffer and point into it rather than copy its strings (job information)
+ */
+#define SLURM_MSG_BORROW_BUFFER	0x0010
+/* Sender can take an LZ4 compressed response body */
+#define SLURM_MSG_ACCEPT_LZ4	0x0020
+/* Message body is LZ4 compressed, see lz4_compress_buf() */
+#define SLURM_MSG_LZ4		0x0040
+
+/* Message bodies smaller than this are never compressed */
+#define SLURM_MSG_COMPRESS_MIN	(64 * 1024)
 
 #include "src/common/slurm_protocol_socket_common.h"
 
@@ -991,71 +991,88 @@ extern void slurm_free_job_info(job_info_t * job)
 	}
 }
 
-extern void slurm_free_job_info_members(job_info_t * job)
+/*
+ * xfree() a field of a job record unless it points into the response buffer
+ * the record was unpacked from, see SHOW_NO_COPY
+ */
+#define _xfree_job_field(_field, _buf) do {				\
+	if (!(_buf) || ((char *) (_field) < get_buf_data(_buf)) ||	\
+	    ((char *) (_field) >= get_buf_data(_buf) + size_buf(_buf)))	\
+		xfree(_field);						\
+	else								\
+		(_field) = NULL;					\
+} while (0)
+
+static void _free_job_info_members(job_info_t *job, Buf buffer)
 {
 	int i;
 
 	if (job) {
-		xfree(job->account);
-		xfree(job->alloc_node);
+		_xfree_job_field(job->account, buffer);
+		_xfree_job_field(job->alloc_node, buffer);
 		if (job->array_bitmap)
 			bit_free((bitstr_t *) job->array_bitmap);
-		xfree(job->array_task_str);
-		xfree(job->batch_features);
-		xfree(job->batch_host);
-		xfree(job->burst_buffer);
-		xfree(job->burst_buffer_state);
-		xfree(job->cluster);
-		xfree(job->command);
-		xfree(job->comment);
-		xfree(job->cpus_per_tres);
-		xfree(job->dependency);
-		xfree(job->exc_nodes);
-		xfree(job->exc_node_inx);
-		xfree(job->features);
-		xfree(job->fed_origin_str);
-		xfree(job->fed_siblings_active_str);
-		xfree(job->fed_siblings_viable_str);
+		_xfree_job_field(job->array_task_str, buffer);
+		_xfree_job_field(job->batch_features, buffer);
+		_xfree_job_field(job->batch_host, buffer);
+		_xfree_job_field(job->burst_buffer, buffer);
+		_xfree_job_field(job->burst_buffer_state, buffer);
+		_xfree_job_field(job->cluster, buffer);
+		_xfree_job_field(job->command, buffer);
+		_xfree_job_field(job->comment, buffer);
+		_xfree_job_field(job->cpus_per_tres, buffer);
+		_xfree_job_field(job->dependency, buffer);
+		_xfree_job_field(job->exc_nodes, buffer);
+		_xfree_job_field(job->exc_node_inx, buffer);
+		_xfree_job_field(job->features, buffer);
+		_xfree_job_field(job->fed_origin_str, buffer);
+		_xfree_job_field(job->fed_siblings_active_str, buffer);
+		_xfree_job_field(job->fed_siblings_viable_str, buffer);
 		if (job->gres_detail_str) {
 			for (i = 0; i < job->gres_detail_cnt; i++)
 				xfree(job->gres_detail_str[i]);
-			xfree(job->gres_detail_str);
+			_xfree_job_field(job->gres_detail_str, buffer);
 		}
-		xfree(job->licenses);
-		xfree(job->mcs_label);
-		xfree(job->mem_per_tres);
-		xfree(job->name);
-		xfree(job->network);
-		xfree(job->node_inx);
-		xfree(job->nodes);
-		xfree(job->sched_nodes);
-		xfree(job->pack_job_id_set);
-		xfree(job->partition);
-		xfree(job->qos);
-		xfree(job->req_node_inx);
-		xfree(job->req_nodes);
-		xfree(job->resv_name);
+		_xfree_job_field(job->licenses, buffer);
+		_xfree_job_field(job->mcs_label, buffer);
+		_xfree_job_field(job->mem_per_tres, buffer);
+		_xfree_job_field(job->name, buffer);
+		_xfree_job_field(job->network, buffer);
+		_xfree_job_field(job->node_inx, buffer);
+		_xfree_job_field(job->nodes, buffer);
+		_xfree_job_field(job->sched_nodes, buffer);
+		_xfree_job_field(job->pack_job_id_set, buffer);
+		_xfree_job_field(job->partition, buffer);
+		_xfree_job_field(job->qos, buffer);
+		_xfree_job_field(job->req_node_inx, buffer);
+		_xfree_job_field(job->req_nodes, buffer);
+		_xfree_job_field(job->resv_name, buffer);
 		select_g_select_jobinfo_free(job->select_jobinfo);
 		job->select_jobinfo = NULL;
 		free_job_resources(&job->job_resrcs);
-		xfree(job->state_desc);
-		xfree(job->std_err);
-		xfree(job->std_in);
-		xfree(job->std_out);
-		xfree(job->tres_alloc_str);
-		xfree(job->tres_bind);
-		xfree(job->tres_freq);
-		xfree(job->tres_per_job);
-		xfree(job->tres_per_node);
-		xfree(job->tres_per_socket);
-		xfree(job->tres_per_task);
-		xfree(job->tres_req_str);
-		xfree(job->user_name);
-		xfree(job->wckey);
-		xfree(job->work_dir);
+		_xfree_job_field(job->state_desc, buffer);
+		_xfree_job_field(job->std_err, buffer);
+		_xfree_job_field(job->std_in, buffer);
+		_xfree_job_field(job->std_out, buffer);
+		_xfree_job_field(job->tres_alloc_str, buffer);
+		_xfree_job_field(job->tres_bind, buffer);
+		_xfree_job_field(job->tres_freq, buffer);
+		_xfree_job_field(job->tres_per_job, buffer);
+		_xfree_job_field(job->tres_per_node, buffer);
+		_xfree_job_field(job->tres_per_socket, buffer);
+		_xfree_job_field(job->tres_per_task, buffer);
+		_xfree_job_field(job->tres_req_str, buffer);
+		_xfree_job_field(job->user_name, buffer);
+		_xfree_job_field(job->wckey, buffer);
+		_xfree_job_field(job->work_dir, buffer);
 	}
 }
 
+extern void slurm_free_job_info_members(job_info_t * job)
+{
+	_free_job_info_members(job, NULL);
+}
+
 
 extern void slurm_free_acct_gather_node_resp_msg(
 	acct_gather_node_resp_msg_t *msg)
@@ -1544,6 +1561,19 @@ extern void slurm_free_stats_response_msg(stats_info_response_msg_t *msg)
 {
 	int i;
 	if (msg) {
+		xfree(msg->lock_rd_cnt);
+		xfree(msg->lock_rd_wait_cnt);
+		xfree(msg->lock_rd_wait_time);
+		xfree(msg->lock_wr_cnt);
+		xfree(msg->lock_wr_wait_cnt);
+		xfree(msg->lock_wr_wait_time);
+		for (i = 0; i < msg->part_sched_count; i++)
+			xfree(msg->part_sched_name[i]);
+		xfree(msg->part_sched_name);
+		xfree(msg->part_sched_test_cnt);
+		xfree(msg->part_sched_test_time);
+		xfree(msg->part_sched_start_cnt);
+		xfree(msg->part_sched_fail_cnt);
 		xfree(msg->rpc_type_id);
 		xfree(msg->rpc_type_cnt);
 		xfree(msg->rpc_type_time);
@@ -3941,6 +3971,8 @@ extern void slurm_free_job_info_msg(job_info_msg_t * job_buffer_ptr)
 			_free_all_job_info(job_buffer_ptr);
 			xfree(job_buffer_ptr->job_array);
 		}
+		xfree(job_buffer_ptr->removed_job_ids);
+		FREE_NULL_BUFFER(job_buffer_ptr->buffer);
 		xfree(job_buffer_ptr);
 	}
 }
@@ -3954,7 +3986,7 @@ static void _free_all_job_info(job_info_msg_t *msg)
 		return;
 
 	for (i = 0; i < msg->record_count; i++)
-		slurm_free_job_info_members (&msg->job_array[i]);
+		_free_job_info_members(&msg->job_array[i], msg->buffer);
 }
 
 /*
@@ -4075,6 +4107,7 @@ extern void slurm_free_node_info_msg(node_info_msg_t * msg)
 			_free_all_node_info(msg);
 			xfree(msg->node_array);
 		}
+		xfree(msg->node_inx);
 		xfree(msg);
 	}
 }
@@ -5223,6 +5256,10 @@ rpc_num2string(uint16_t opcode)
 		return "REQUEST_BURST_BUFFER_STATUS";
 	case RESPONSE_BURST_BUFFER_STATUS:
 		return "RESPONSE_BURST_BUFFER_STATUS";
+	case RESPONSE_JOB_INFO_DELTA:
+		return "RESPONSE_JOB_INFO_DELTA";
+	case RESPONSE_NODE_INFO_DELTA:
+		return "RESPONSE_NODE_INFO_DELTA";
 
 	case REQUEST_UPDATE_JOB:				/* 3001 */
 		return "REQUEST_UPDATE_JOB";
@@ -104,6 +104,30 @@ extern ssize_t slurm_msg_sendto_timeout(int open_fd,
 					size_t size,
 					int timeout);
 
+/* slurm_msg_sendto_vec
+ * Send a message held in two separate buffers over the given connection,
+ * as if they were one contiguous buffer, without copying them together
+ * IN open_fd - an open file descriptor
+ * IN head - first part of the message
+ * IN head_size - size of head in bytes
+ * IN data - rest of the message, may be NULL if data_size is zero
+ * IN data_size - size of data in bytes
+ * RET number of bytes written
+ */
+extern ssize_t slurm_msg_sendto_vec(int open_fd,
+				    char *head,
+				    size_t head_size,
+				    char *data,
+				    size_t data_size);
+/* slurm_msg_sendto_vec_timeout is identical to slurm_msg_sendto_vec except
+ * IN timeout - maximum time to wait for a message in milliseconds */
+extern ssize_t slurm_msg_sendto_vec_timeout(int open_fd,
+					    char *head,
+					    size_t head_size,
+					    char *data,
+					    size_t data_size,
+					    int timeout);
+
 /********************/
 /* stream functions */
 /********************/
@@ -167,6 +167,8 @@ static void _pack_node_info_single_msg(node_info_single_msg_t * msg,
 static int _unpack_node_info_single_msg(node_info_single_msg_t ** msg,
 					Buf buffer, uint16_t protocol_version);
 
+static int _unpack_node_info_delta_msg(node_info_msg_t **msg, Buf buffer,
+				       uint16_t protocol_version);
 static int _unpack_node_info_msg(node_info_msg_t ** msg, Buf buffer,
 				 uint16_t protocol_version);
 static int _unpack_node_info_members(node_info_t * node, Buf buffer,
@@ -416,7 +418,7 @@ static int _unpack_step_complete_msg(step_complete_msg_t **
 				     msg_ptr, Buf buffer,
 				     uint16_t protocol_version);
 static int _unpack_job_info_members(job_info_t * job, Buf buffer,
-				    uint16_t protocol_version);
+				    uint16_t protocol_version, bool borrow);
 
 static void _pack_batch_job_launch_msg(batch_job_launch_msg_t * msg,
 				       Buf buffer,
@@ -452,7 +454,9 @@ static int _unpack_job_script_msg(char **msg, Buf buffer,
 				  uint16_t protocol_version);
 
 static int _unpack_job_info_msg(job_info_msg_t ** msg, Buf buffer,
-				uint16_t protocol_version);
+				uint16_t protocol_version, bool borrow);
+static int _unpack_job_info_delta_msg(job_info_msg_t **msg, Buf buffer,
+				      uint16_t protocol_version);
 
 static void _pack_node_reg_resp(slurm_node_reg_resp_msg_t *msg,
 				Buf buffer, uint16_t protocol_version);
@@ -884,6 +888,36 @@ unpack_error:
 }
 
 
+/* pack_msg_prepacked
+ * returns true if the body of this message is msg->data, already packed by
+ *	the sender, see _pack_buffer_msg()
+ * IN msg - the message to check
+ */
+extern bool pack_msg_prepacked(slurm_msg_t const *msg)
+{
+	if (msg->protocol_version < SLURM_MIN_PROTOCOL_VERSION)
+		return false;
+
+	switch (msg->msg_type) {
+	case RESPONSE_JOB_INFO:
+	case RESPONSE_JOB_INFO_DELTA:
+	case RESPONSE_PARTITION_INFO:
+	case RESPONSE_NODE_INFO:
+	case RESPONSE_NODE_INFO_DELTA:
+	case RESPONSE_RESERVATION_INFO:
+	case RESPONSE_LAYOUT_INFO:
+	case RESPONSE_JOB_STEP_INFO:
+	case RESPONSE_FRONT_END_INFO:
+	case RESPONSE_BURST_BUFFER_INFO:
+	case RESPONSE_STATS_INFO:
+	case RESPONSE_LICENSE_INFO:
+	case RESPONSE_ASSOC_MGR_INFO:
+		return true;
+	default:
+		return false;
+	}
+}
+
 /* pack_msg
  * packs a generic slurm protocol message body
  * IN msg - the body structure to pack (note: includes message type)
@@ -938,6 +972,7 @@ pack_msg(slurm_msg_t const *msg, Buf buffer)
 					 msg->protocol_version);
 		break;
 	case RESPONSE_JOB_INFO:
+	case RESPONSE_JOB_INFO_DELTA:
 		_pack_job_info_msg((slurm_msg_t *) msg, buffer);
 		break;
 	case RESPONSE_BATCH_SCRIPT:
@@ -948,6 +983,7 @@ pack_msg(slurm_msg_t const *msg, Buf buffer)
 		_pack_partition_info_msg((slurm_msg_t *) msg, buffer);
 		break;
 	case RESPONSE_NODE_INFO:
+	case RESPONSE_NODE_INFO_DELTA:
 		_pack_node_info_msg((slurm_msg_t *) msg, buffer);
 		break;
 	case MESSAGE_NODE_REGISTRATION_STATUS:
@@ -1632,8 +1668,14 @@ unpack_msg(slurm_msg_t * msg, Buf buffer)
 		break;
 	case RESPONSE_JOB_INFO:
 		rc = _unpack_job_info_msg((job_info_msg_t **) & (msg->data),
-					  buffer,
-					  msg->protocol_version);
+					  buffer, msg->protocol_version,
+					  (msg->flags &
+					   SLURM_MSG_BORROW_BUFFER));
+		break;
+	case RESPONSE_JOB_INFO_DELTA:
+		rc = _unpack_job_info_delta_msg(
+			(job_info_msg_t **) &(msg->data), buffer,
+			msg->protocol_version);
 		break;
 	case RESPONSE_BATCH_SCRIPT:
 		rc = _unpack_job_script_msg((char **) &(msg->data),
@@ -1650,6 +1692,11 @@ unpack_msg(slurm_msg_t * msg, Buf buffer)
 					   (msg->data), buffer,
 					   msg->protocol_version);
 		break;
+	case RESPONSE_NODE_INFO_DELTA:
+		rc = _unpack_node_info_delta_msg(
+			(node_info_msg_t **) &(msg->data), buffer,
+			msg->protocol_version);
+		break;
 	case MESSAGE_NODE_REGISTRATION_STATUS:
 		rc = _unpack_node_registration_status_msg(
 			(slurm_node_registration_status_msg_t **)
@@ -3720,6 +3767,38 @@ unpack_error:
 	return SLURM_ERROR;
 }
 
+/*
+ * A node information delta is a node information message containing only
+ * the changed records, followed by the node table index of each record
+ */
+static int _unpack_node_info_delta_msg(node_info_msg_t **msg, Buf buffer,
+				       uint16_t protocol_version)
+{
+	uint32_t uint32_tmp;
+	node_info_msg_t *tmp_ptr;
+
+	if (_unpack_node_info_msg(msg, buffer, protocol_version))
+		return SLURM_ERROR;
+	tmp_ptr = *msg;
+	tmp_ptr->delta = 1;
+
+	if (protocol_version >= SLURM_19_05_PROTOCOL_VERSION) {
+		safe_unpack32_array(&tmp_ptr->node_inx, &uint32_tmp, buffer);
+		if (uint32_tmp != tmp_ptr->record_count)
+			goto unpack_error;
+	} else {
+		error("%s: protocol_version %hu not supported",
+		      __func__, protocol_version);
+		goto unpack_error;
+	}
+	return SLURM_SUCCESS;
+
+unpack_error:
+	slurm_free_node_info_msg(tmp_ptr);
+	*msg = NULL;
+	return SLURM_ERROR;
+}
+
 static int
 _unpack_node_info_members(node_info_t * node, Buf buffer,
 			  uint16_t protocol_version)
@@ -5540,7 +5619,7 @@ unpack_error:
 
 static int
 _unpack_job_info_msg(job_info_msg_t ** msg, Buf buffer,
-		     uint16_t protocol_version)
+		     uint16_t protocol_version, bool borrow)
 {
 	int i;
 	job_info_t *job = NULL;
@@ -5548,6 +5627,19 @@ _unpack_job_info_msg(job_info_msg_t ** msg, Buf buffer,
 	xassert(msg != NULL);
 	*msg = xmalloc(sizeof(job_info_msg_t));
 
+	if (borrow) {
+		/*
+		 * Take over the received data so that the records' strings
+		 * can point into it, it is freed along with the message
+		 */
+		Buf data = create_buf(get_buf_data(buffer), size_buf(buffer));
+		set_buf_offset(data, get_buf_offset(buffer));
+		buffer->head = NULL;
+		buffer->size = buffer->processed = 0;
+		(*msg)->buffer = data;
+		buffer = data;
+	}
+
 	/* load buffer's header (data structure version and time) */
 	if (protocol_version >= SLURM_MIN_PROTOCOL_VERSION) {
 		safe_unpack32(&((*msg)->record_count), buffer);
@@ -5559,7 +5651,7 @@ _unpack_job_info_msg(job_info_msg_t ** msg, Buf buffer,
 		/* load individual job info */
 		for (i = 0; i < (*msg)->record_count; i++) {
 			if (_unpack_job_info_members(&job[i], buffer,
-						     protocol_version))
+						     protocol_version, borrow))
 				goto unpack_error;
 		}
 	} else {
@@ -5575,6 +5667,33 @@ unpack_error:
 	return SLURM_ERROR;
 }
 
+/*
+ * A job information delta is a job information message containing only the
+ * changed records, followed by the IDs of jobs which have been removed
+ */
+static int _unpack_job_info_delta_msg(job_info_msg_t **msg, Buf buffer,
+				      uint16_t protocol_version)
+{
+	if (_unpack_job_info_msg(msg, buffer, protocol_version, false))
+		return SLURM_ERROR;
+	(*msg)->delta = 1;
+
+	if (protocol_version >= SLURM_19_05_PROTOCOL_VERSION) {
+		safe_unpack32_array(&(*msg)->removed_job_ids,
+				    &(*msg)->removed_cnt, buffer);
+	} else {
+		error("%s: protocol_version %hu not supported",
+		      __func__, protocol_version);
+		goto unpack_error;
+	}
+	return SLURM_SUCCESS;
+
+unpack_error:
+	slurm_free_job_info_msg(*msg);
+	*msg = NULL;
+	return SLURM_ERROR;
+}
+
 /* Translate bitmap representation from hex to decimal format, replacing
  * array_task_str and store the bitmap in job->array_bitmap. */
 static void _xlate_task_str(job_info_t *job_ptr)
@@ -5664,7 +5783,7 @@ out:
  */
 static int
 _unpack_job_info_members(job_info_t * job, Buf buffer,
-			 uint16_t protocol_version)
+			 uint16_t protocol_version, bool borrow)
 {
 	uint32_t uint32_tmp = 0;
 	multi_core_data_t *mc_ptr;
@@ -5688,8 +5807,8 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 		safe_unpack32(&job->user_id,  buffer);
 		safe_unpack32(&job->group_id, buffer);
 		safe_unpack32(&job->pack_job_id, buffer);
-		safe_unpackstr_xmalloc(&job->pack_job_id_set, &uint32_tmp,
-				       buffer);
+		safe_unpackstr_borrow(&job->pack_job_id_set, &uint32_tmp,
+				      buffer, borrow);
 		safe_unpack32(&job->pack_job_offset, buffer);
 		safe_unpack32(&job->profile,  buffer);
 
@@ -5720,27 +5839,40 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 		safe_unpack_time(&job->preempt_time, buffer);
 		safe_unpack32(&job->priority, buffer);
 		safe_unpackdouble(&job->billable_tres, buffer);
-		safe_unpackstr_xmalloc(&job->cluster, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->nodes, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->sched_nodes, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->partition, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->account, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->admin_comment, &uint32_tmp,buffer);
-		safe_unpackstr_xmalloc(&job->network, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->comment, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->batch_features, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->batch_host, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->burst_buffer, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->burst_buffer_state, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->system_comment,
-				       &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->qos, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->licenses, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->state_desc, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->resv_name,  &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->mcs_label,  &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->cluster, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->nodes, &uint32_tmp, buffer, borrow);
+		safe_unpackstr_borrow(&job->sched_nodes, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->partition, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->account, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->admin_comment, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->network, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->comment, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->batch_features, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->batch_host, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->burst_buffer, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->burst_buffer_state, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->system_comment, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->qos, &uint32_tmp, buffer, borrow);
+		safe_unpackstr_borrow(&job->licenses, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->state_desc, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->resv_name, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->mcs_label, &uint32_tmp,
+				      buffer, borrow);
 
 		safe_unpack32(&job->exit_code, buffer);
 		safe_unpack32(&job->derived_ec, buffer);
@@ -5749,13 +5881,15 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 		safe_unpackstr_array(&job->gres_detail_str,
 				     &job->gres_detail_cnt, buffer);
 
-		safe_unpackstr_xmalloc(&job->name, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->user_name, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->wckey, &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->name, &uint32_tmp, buffer, borrow);
+		safe_unpackstr_borrow(&job->user_name, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->wckey, &uint32_tmp, buffer, borrow);
 		safe_unpack32(&job->req_switch, buffer);
 		safe_unpack32(&job->wait4switch, buffer);
 
-		safe_unpackstr_xmalloc(&job->alloc_node, &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->alloc_node, &uint32_tmp,
+				      buffer, borrow);
 
 		unpack_bit_str_hex_as_inx(&job->node_inx, buffer);
 
@@ -5764,12 +5898,16 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 			goto unpack_error;
 
 		/*** unpack default job details ***/
-		safe_unpackstr_xmalloc(&job->features,   &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->cluster_features, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->work_dir,   &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->dependency, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->command,    &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->features, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->cluster_features, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->work_dir, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->dependency, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->command, &uint32_tmp,
+				      buffer, borrow);
 
 		safe_unpack32(&job->num_cpus, buffer);
 		safe_unpack32(&job->max_cpus, buffer);
@@ -5792,17 +5930,22 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 
 		safe_unpack64(&job->pn_min_memory, buffer);
 		safe_unpack32(&job->pn_min_tmp_disk, buffer);
-		safe_unpackstr_xmalloc(&job->req_nodes, &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->req_nodes, &uint32_tmp,
+				      buffer, borrow);
 
 		unpack_bit_str_hex_as_inx(&job->req_node_inx, buffer);
 
-		safe_unpackstr_xmalloc(&job->exc_nodes, &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->exc_nodes, &uint32_tmp,
+				      buffer, borrow);
 
 		unpack_bit_str_hex_as_inx(&job->exc_node_inx, buffer);
 
-		safe_unpackstr_xmalloc(&job->std_err, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->std_in,  &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->std_out, &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->std_err, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->std_in, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->std_out, &uint32_tmp,
+				      buffer, borrow);
 
 		if (unpack_multi_core_data(&mc_ptr, buffer, protocol_version))
 			goto unpack_error;
@@ -5818,37 +5961,37 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 			xfree(mc_ptr);
 		}
 		safe_unpack32(&job->bitflags, buffer);
-		safe_unpackstr_xmalloc(&job->tres_alloc_str,
-				       &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->tres_req_str,
-				       &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->tres_alloc_str, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->tres_req_str, &uint32_tmp,
+				      buffer, borrow);
 		safe_unpack16(&job->start_protocol_ver, buffer);
 
-		safe_unpackstr_xmalloc(&job->fed_origin_str, &uint32_tmp,
-				       buffer);
+		safe_unpackstr_borrow(&job->fed_origin_str, &uint32_tmp,
+				      buffer, borrow);
 		safe_unpack64(&job->fed_siblings_active, buffer);
-		safe_unpackstr_xmalloc(&job->fed_siblings_active_str,
-				       &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->fed_siblings_active_str,
+				      &uint32_tmp, buffer, borrow);
 		safe_unpack64(&job->fed_siblings_viable, buffer);
-		safe_unpackstr_xmalloc(&job->fed_siblings_viable_str,
-				       &uint32_tmp, buffer);
-
-		safe_unpackstr_xmalloc(&job->cpus_per_tres, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->mem_per_tres, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->tres_bind, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->tres_freq, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->tres_per_job, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->tres_per_node, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->tres_per_socket, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->tres_per_task, &uint32_tmp,
-				       buffer);
+		safe_unpackstr_borrow(&job->fed_siblings_viable_str,
+				      &uint32_tmp, buffer, borrow);
+
+		safe_unpackstr_borrow(&job->cpus_per_tres, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->mem_per_tres, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->tres_bind, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->tres_freq, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->tres_per_job, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->tres_per_node, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->tres_per_socket, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->tres_per_task, &uint32_tmp,
+				      buffer, borrow);
 	} else if (protocol_version >= SLURM_MIN_PROTOCOL_VERSION) {
 		safe_unpack32(&job->array_job_id, buffer);
 		safe_unpack32(&job->array_task_id, buffer);
@@ -5868,8 +6011,8 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 		safe_unpack32(&job->user_id,  buffer);
 		safe_unpack32(&job->group_id, buffer);
 		safe_unpack32(&job->pack_job_id, buffer);
-		safe_unpackstr_xmalloc(&job->pack_job_id_set, &uint32_tmp,
-				       buffer);
+		safe_unpackstr_borrow(&job->pack_job_id_set, &uint32_tmp,
+				      buffer, borrow);
 		safe_unpack32(&job->pack_job_offset, buffer);
 		safe_unpack32(&job->profile,  buffer);
 
@@ -5899,25 +6042,38 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 		safe_unpack_time(&job->preempt_time, buffer);
 		safe_unpack32(&job->priority, buffer);
 		safe_unpackdouble(&job->billable_tres, buffer);
-		safe_unpackstr_xmalloc(&job->cluster, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->nodes, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->sched_nodes, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->partition, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->account, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->admin_comment, &uint32_tmp,buffer);
-		safe_unpackstr_xmalloc(&job->network, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->comment, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->tres_per_node, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->batch_host, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->burst_buffer, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->burst_buffer_state, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->qos, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->licenses, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->state_desc, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->resv_name,  &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->mcs_label,  &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->cluster, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->nodes, &uint32_tmp, buffer, borrow);
+		safe_unpackstr_borrow(&job->sched_nodes, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->partition, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->account, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->admin_comment, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->network, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->comment, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->tres_per_node, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->batch_host, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->burst_buffer, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->burst_buffer_state, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->qos, &uint32_tmp, buffer, borrow);
+		safe_unpackstr_borrow(&job->licenses, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->state_desc, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->resv_name, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->mcs_label, &uint32_tmp,
+				      buffer, borrow);
 
 		safe_unpack32(&job->exit_code, buffer);
 		safe_unpack32(&job->derived_ec, buffer);
@@ -5926,13 +6082,15 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 		safe_unpackstr_array(&job->gres_detail_str,
 				     &job->gres_detail_cnt, buffer);
 
-		safe_unpackstr_xmalloc(&job->name, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->user_name, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->wckey, &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->name, &uint32_tmp, buffer, borrow);
+		safe_unpackstr_borrow(&job->user_name, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->wckey, &uint32_tmp, buffer, borrow);
 		safe_unpack32(&job->req_switch, buffer);
 		safe_unpack32(&job->wait4switch, buffer);
 
-		safe_unpackstr_xmalloc(&job->alloc_node, &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->alloc_node, &uint32_tmp,
+				      buffer, borrow);
 
 		unpack_bit_str_hex_as_inx(&job->node_inx, buffer);
 
@@ -5941,12 +6099,16 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 			goto unpack_error;
 
 		/*** unpack default job details ***/
-		safe_unpackstr_xmalloc(&job->features,   &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->cluster_features, &uint32_tmp,
-				       buffer);
-		safe_unpackstr_xmalloc(&job->work_dir,   &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->dependency, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->command,    &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->features, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->cluster_features, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->work_dir, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->dependency, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->command, &uint32_tmp,
+				      buffer, borrow);
 
 		safe_unpack32(&job->num_cpus, buffer);
 		safe_unpack32(&job->max_cpus, buffer);
@@ -5969,17 +6131,22 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 
 		safe_unpack64(&job->pn_min_memory, buffer);
 		safe_unpack32(&job->pn_min_tmp_disk, buffer);
-		safe_unpackstr_xmalloc(&job->req_nodes, &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->req_nodes, &uint32_tmp,
+				      buffer, borrow);
 
 		unpack_bit_str_hex_as_inx(&job->req_node_inx, buffer);
 
-		safe_unpackstr_xmalloc(&job->exc_nodes, &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->exc_nodes, &uint32_tmp,
+				      buffer, borrow);
 
 		unpack_bit_str_hex_as_inx(&job->exc_node_inx, buffer);
 
-		safe_unpackstr_xmalloc(&job->std_err, &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->std_in,  &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->std_out, &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->std_err, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->std_in, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->std_out, &uint32_tmp,
+				      buffer, borrow);
 
 		if (unpack_multi_core_data(&mc_ptr, buffer, protocol_version))
 			goto unpack_error;
@@ -5995,20 +6162,20 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 			xfree(mc_ptr);
 		}
 		safe_unpack32(&job->bitflags, buffer);
-		safe_unpackstr_xmalloc(&job->tres_alloc_str,
-				       &uint32_tmp, buffer);
-		safe_unpackstr_xmalloc(&job->tres_req_str,
-				       &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->tres_alloc_str, &uint32_tmp,
+				      buffer, borrow);
+		safe_unpackstr_borrow(&job->tres_req_str, &uint32_tmp,
+				      buffer, borrow);
 		safe_unpack16(&job->start_protocol_ver, buffer);
 
-		safe_unpackstr_xmalloc(&job->fed_origin_str, &uint32_tmp,
-				       buffer);
+		safe_unpackstr_borrow(&job->fed_origin_str, &uint32_tmp,
+				      buffer, borrow);
 		safe_unpack64(&job->fed_siblings_active, buffer);
-		safe_unpackstr_xmalloc(&job->fed_siblings_active_str, &uint32_tmp,
-				       buffer);
+		safe_unpackstr_borrow(&job->fed_siblings_active_str,
+				      &uint32_tmp, buffer, borrow);
 		safe_unpack64(&job->fed_siblings_viable, buffer);
-		safe_unpackstr_xmalloc(&job->fed_siblings_viable_str,
-				       &uint32_tmp, buffer);
+		safe_unpackstr_borrow(&job->fed_siblings_viable_str,
+				      &uint32_tmp, buffer, borrow);
 	} else {
 		error("_unpack_job_info_members: protocol_version "
 		      "%hu not supported", protocol_version);
@@ -6017,7 +6184,9 @@ _unpack_job_info_members(job_info_t * job, Buf buffer,
 	return SLURM_SUCCESS;
 
 unpack_error:
-	slurm_free_job_info_members(job);
+	/* Borrowed strings are left for slurm_free_job_info_msg() */
+	if (!borrow)
+		slurm_free_job_info_members(job);
 	return SLURM_ERROR;
 }
 
@@ -8091,7 +8260,8 @@ _pack_sib_msg(sib_msg_t *sib_msg_ptr, Buf buffer, uint16_t protocol_version)
 
 			pack16(1, buffer);
 
-			grow_buf(buffer, grow_size);
+			if (try_grow_buf_remaining(buffer, grow_size))
+				return;
 			memcpy(&buffer->head[get_buf_offset(buffer)],
 			       &dbuf->head[sib_msg_ptr->data_offset],
 			       grow_size);
@@ -12946,7 +13116,7 @@ static void _pack_file_bcast(file_bcast_msg_t * msg , Buf buffer,
 {
 	xassert ( msg != NULL );
 
-	grow_buf(buffer,  msg->block_len);
+	try_grow_buf_remaining(buffer, msg->block_len + BUF_SIZE);
 
 	if (protocol_version >= SLURM_MIN_PROTOCOL_VERSION) {
 		pack32(msg->block_no, buffer);
@@ -13869,7 +14039,124 @@ static int  _unpack_stats_response_msg(stats_info_response_msg_t **msg_ptr,
 	msg = xmalloc ( sizeof (stats_info_response_msg_t) );
 	*msg_ptr = msg ;
 
-	if (protocol_version >= SLURM_18_08_PROTOCOL_VERSION) {
+	if (protocol_version >= SLURM_19_05_PROTOCOL_VERSION) {
+		safe_unpack32(&msg->parts_packed,	buffer);
+		if (msg->parts_packed) {
+			safe_unpack_time(&msg->req_time,	buffer);
+			safe_unpack_time(&msg->req_time_start,	buffer);
+			safe_unpack32(&msg->server_thread_count,buffer);
+			safe_unpack32(&msg->agent_queue_size,	buffer);
+			safe_unpack32(&msg->agent_count,	buffer);
+			safe_unpack32(&msg->dbd_agent_queue_size, buffer);
+			safe_unpack32(&msg->gettimeofday_latency, buffer);
+			safe_unpack32(&msg->jobs_submitted,	buffer);
+			safe_unpack32(&msg->jobs_started,	buffer);
+			safe_unpack32(&msg->jobs_completed,	buffer);
+			safe_unpack32(&msg->jobs_canceled,	buffer);
+			safe_unpack32(&msg->jobs_failed,	buffer);
+
+			safe_unpack32(&msg->jobs_pending,	buffer);
+			safe_unpack32(&msg->jobs_running,	buffer);
+			safe_unpack_time(&msg->job_states_ts,	buffer);
+
+			safe_unpack32(&msg->schedule_cycle_max,	buffer);
+			safe_unpack32(&msg->schedule_cycle_last,buffer);
+			safe_unpack32(&msg->schedule_cycle_sum,	buffer);
+			safe_unpack32(&msg->schedule_cycle_counter, buffer);
+			safe_unpack32(&msg->schedule_cycle_depth, buffer);
+			safe_unpack32(&msg->schedule_queue_len,	buffer);
+
+			safe_unpack32(&msg->bf_backfilled_jobs,	buffer);
+			safe_unpack32(&msg->bf_last_backfilled_jobs, buffer);
+			safe_unpack32(&msg->bf_cycle_counter,	buffer);
+			safe_unpack64(&msg->bf_cycle_sum,	buffer);
+			safe_unpack32(&msg->bf_cycle_last,	buffer);
+			safe_unpack32(&msg->bf_last_depth,	buffer);
+			safe_unpack32(&msg->bf_last_depth_try,	buffer);
+
+			safe_unpack32(&msg->bf_queue_len,	buffer);
+			safe_unpack32(&msg->bf_cycle_max,	buffer);
+			safe_unpack_time(&msg->bf_when_last_cycle, buffer);
+			safe_unpack32(&msg->bf_depth_sum,	buffer);
+			safe_unpack32(&msg->bf_depth_try_sum,	buffer);
+			safe_unpack32(&msg->bf_queue_len_sum,	buffer);
+
+			safe_unpack32(&msg->bf_active,		buffer);
+			safe_unpack32(&msg->bf_backfilled_pack_jobs, buffer);
+
+			safe_unpack32(&msg->lock_type_count,	buffer);
+			safe_unpack64_array(&msg->lock_rd_cnt,
+					    &uint32_tmp, buffer);
+			if (uint32_tmp != msg->lock_type_count)
+				goto unpack_error;
+			safe_unpack64_array(&msg->lock_rd_wait_cnt,
+					    &uint32_tmp, buffer);
+			if (uint32_tmp != msg->lock_type_count)
+				goto unpack_error;
+			safe_unpack64_array(&msg->lock_rd_wait_time,
+					    &uint32_tmp, buffer);
+			if (uint32_tmp != msg->lock_type_count)
+				goto unpack_error;
+			safe_unpack64_array(&msg->lock_wr_cnt,
+					    &uint32_tmp, buffer);
+			if (uint32_tmp != msg->lock_type_count)
+				goto unpack_error;
+			safe_unpack64_array(&msg->lock_wr_wait_cnt,
+					    &uint32_tmp, buffer);
+			if (uint32_tmp != msg->lock_type_count)
+				goto unpack_error;
+			safe_unpack64_array(&msg->lock_wr_wait_time,
+					    &uint32_tmp, buffer);
+			if (uint32_tmp != msg->lock_type_count)
+				goto unpack_error;
+
+			safe_unpackstr_array(&msg->part_sched_name,
+					     &msg->part_sched_count, buffer);
+			safe_unpack32_array(&msg->part_sched_test_cnt,
+					    &uint32_tmp, buffer);
+			if (uint32_tmp != msg->part_sched_count)
+				goto unpack_error;
+			safe_unpack64_array(&msg->part_sched_test_time,
+					    &uint32_tmp, buffer);
+			if (uint32_tmp != msg->part_sched_count)
+				goto unpack_error;
+			safe_unpack32_array(&msg->part_sched_start_cnt,
+					    &uint32_tmp, buffer);
+			if (uint32_tmp != msg->part_sched_count)
+				goto unpack_error;
+			safe_unpack32_array(&msg->part_sched_fail_cnt,
+					    &uint32_tmp, buffer);
+			if (uint32_tmp != msg->part_sched_count)
+				goto unpack_error;
+		}
+
+		safe_unpack32(&msg->rpc_type_size,		buffer);
+		safe_unpack16_array(&msg->rpc_type_id,   &uint32_tmp, buffer);
+		safe_unpack32_array(&msg->rpc_type_cnt,  &uint32_tmp, buffer);
+		safe_unpack64_array(&msg->rpc_type_time, &uint32_tmp, buffer);
+
+		safe_unpack32(&msg->rpc_user_size,		buffer);
+		safe_unpack32_array(&msg->rpc_user_id,   &uint32_tmp, buffer);
+		safe_unpack32_array(&msg->rpc_user_cnt,  &uint32_tmp, buffer);
+		safe_unpack64_array(&msg->rpc_user_time, &uint32_tmp, buffer);
+
+		safe_unpack32_array(&msg->rpc_queue_type_id,
+				    &msg->rpc_queue_type_count,
+				    buffer);
+		safe_unpack32_array(&msg->rpc_queue_count,
+				    &uint32_tmp, buffer);
+		if (uint32_tmp != msg->rpc_queue_type_count)
+			goto unpack_error;
+
+		safe_unpack32_array(&msg->rpc_dump_types,
+				    &msg->rpc_dump_count,
+				    buffer);
+		safe_unpackstr_array(&msg->rpc_dump_hostlist,
+				     &uint32_tmp,
+				     buffer);
+		if (uint32_tmp != msg->rpc_dump_count)
+			goto unpack_error;
+	} else if (protocol_version >= SLURM_18_08_PROTOCOL_VERSION) {
 		safe_unpack32(&msg->parts_packed,	buffer);
 		if (msg->parts_packed) {
 			safe_unpack_time(&msg->req_time,	buffer);
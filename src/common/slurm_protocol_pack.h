@@ -80,6 +80,14 @@ extern int unpack_header ( header_t * header , Buf buffer );
  */
 extern int pack_msg ( slurm_msg_t const * msg , Buf buffer );
 
+/* pack_msg_prepacked
+ * returns true if the body of this message is msg->data, already packed by
+ *	the sender (e.g. job or node information responses), in which case
+ *	pack_msg() would only copy its msg->data_size bytes into the buffer
+ * IN msg - the message to check
+ */
+extern bool pack_msg_prepacked(slurm_msg_t const *msg);
+
 /* unpack_msg
  * unpacks a generic slurm protocol message body
  * OUT msg - the body structure to unpack (note: includes message type)
@@ -52,6 +52,7 @@
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "slurm/slurm_errno.h"
@@ -82,6 +83,8 @@
 /* Static functions */
 static int _slurm_connect(int __fd, struct sockaddr const * __addr,
 			  socklen_t __len);
+static int _send_iov_timeout(int fd, struct iovec *iov, int iovcnt,
+			     uint32_t flags, int timeout);
 
 /****************************************************************
  * MIDDLE LAYER MSG FUNCTIONS
@@ -170,10 +173,27 @@ extern ssize_t slurm_msg_sendto(int fd, char *buffer, size_t size)
 
 ssize_t slurm_msg_sendto_timeout(int fd, char *buffer,
 				 size_t size, int timeout)
+{
+	return slurm_msg_sendto_vec_timeout(fd, buffer, size, NULL, 0, timeout);
+}
+
+extern ssize_t slurm_msg_sendto_vec(int fd, char *head, size_t head_size,
+				    char *data, size_t data_size)
+{
+	return slurm_msg_sendto_vec_timeout(fd, head, head_size,
+					    data, data_size,
+					    (slurm_get_msg_timeout() * 1000));
+}
+
+extern ssize_t slurm_msg_sendto_vec_timeout(int fd, char *head,
+					    size_t head_size, char *data,
+					    size_t data_size, int timeout)
 {
 	int   len;
 	uint32_t usize;
 	SigFunc *ohandler;
+	struct iovec iov[3];
+	int iovcnt = 0;
 
 	/*
 	 *  Ignore SIGPIPE so that send can return a error code if the
@@ -181,35 +201,53 @@ ssize_t slurm_msg_sendto_timeout(int fd, char *buffer,
 	 */
 	ohandler = xsignal(SIGPIPE, SIG_IGN);
 
-	usize = htonl(size);
+	usize = htonl(head_size + data_size);
 
-	if ((len = slurm_send_timeout(
-				fd, (char *)&usize, sizeof(usize), 0,
-				timeout)) < 0)
-		goto done;
-
-	if ((len = slurm_send_timeout(fd, buffer, size, 0, timeout)) < 0)
-		goto done;
+	/*
+	 * Hand the length, head and data to the kernel together rather than
+	 * copying them into one buffer or sending them one at a time.
+	 */
+	iov[iovcnt].iov_base = &usize;
+	iov[iovcnt++].iov_len = sizeof(usize);
+	iov[iovcnt].iov_base = head;
+	iov[iovcnt++].iov_len = head_size;
+	if (data_size) {
+		iov[iovcnt].iov_base = data;
+		iov[iovcnt++].iov_len = data_size;
+	}
 
+	len = _send_iov_timeout(fd, iov, iovcnt, 0, timeout);
+	if (len >= 0)
+		len -= sizeof(usize);
 
-     done:
 	xsignal(SIGPIPE, ohandler);
 	return len;
 }
 
-/* Send slurm message with timeout
- * RET message size (as specified in argument) or SLURM_ERROR on error */
-extern int slurm_send_timeout(int fd, char *buf, size_t size,
-			      uint32_t flags, int timeout)
+/*
+ * Send all of the given iovec array with timeout
+ * NOTE: iov is modified as it is sent
+ * RET total size of the iovec array or SLURM_ERROR on error
+ */
+static int _send_iov_timeout(int fd, struct iovec *iov, int iovcnt,
+			     uint32_t flags, int timeout)
 {
-	int rc;
-	int sent = 0;
+	int rc, i;
+	size_t size = 0, sent = 0, n;
 	int fd_flags;
 	struct pollfd ufds;
 	struct timeval tstart;
+	struct msghdr msg;
 	int timeleft = timeout;
 	char temp[2];
 
+	for (i = 0; i < iovcnt; i++)
+		size += iov[i].iov_len;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = iov;
+	msg.msg_iovlen = iovcnt;
+
 	ufds.fd     = fd;
 	ufds.events = POLLOUT;
 
@@ -221,76 +259,86 @@ extern int slurm_send_timeout(int fd, char *buf, size_t size,
 	while (sent < size) {
 		timeleft = timeout - _tot_wait(&tstart);
 		if (timeleft <= 0) {
-			debug("slurm_send_timeout at %d of %zu, timeout",
-				sent, size);
+			debug("%s at %zu of %zu, timeout",
+			      __func__, sent, size);
 			slurm_seterrno(SLURM_PROTOCOL_SOCKET_IMPL_TIMEOUT);
-			sent = SLURM_ERROR;
+			rc = SLURM_ERROR;
 			goto done;
 		}
 
 		if ((rc = poll(&ufds, 1, timeleft)) <= 0) {
 			if ((rc == 0) || (errno == EINTR) || (errno == EAGAIN))
- 				continue;
-			else {
-				debug("slurm_send_timeout at %d of %zu, "
-					"poll error: %s",
-					sent, size, strerror(errno));
-				slurm_seterrno(SLURM_COMMUNICATIONS_SEND_ERROR);
-				sent = SLURM_ERROR;
-				goto done;
-			}
+				continue;
+			debug("%s at %zu of %zu, poll error: %s",
+			      __func__, sent, size, strerror(errno));
+			slurm_seterrno(SLURM_COMMUNICATIONS_SEND_ERROR);
+			rc = SLURM_ERROR;
+			goto done;
 		}
 
 		/*
 		 * Check here to make sure the socket really is there.
 		 * If not then exit out and notify the sender.  This
- 		 * is here since a write doesn't always tell you the
+		 * is here since a write doesn't always tell you the
 		 * socket is gone, but getting 0 back from a
 		 * nonblocking read means just that.
 		 */
 		if (ufds.revents & POLLERR) {
-			debug("slurm_send_timeout: Socket POLLERR");
+			debug("%s: Socket POLLERR", __func__);
 			slurm_seterrno(ENOTCONN);
-			sent = SLURM_ERROR;
+			rc = SLURM_ERROR;
 			goto done;
 		}
 		if ((ufds.revents & POLLHUP) || (ufds.revents & POLLNVAL) ||
 		    (recv(fd, &temp, 1, flags) == 0)) {
-			debug2("slurm_send_timeout: Socket no longer there");
+			debug2("%s: Socket no longer there", __func__);
 			slurm_seterrno(ENOTCONN);
-			sent = SLURM_ERROR;
+			rc = SLURM_ERROR;
 			goto done;
 		}
 		if ((ufds.revents & POLLOUT) != POLLOUT) {
-			error("slurm_send_timeout: Poll failure, revents:%d",
-			      ufds.revents);
+			error("%s: Poll failure, revents:%d",
+			      __func__, ufds.revents);
 		}
 
-		rc = send(fd, &buf[sent], (size - sent), flags);
+		rc = sendmsg(fd, &msg, flags);
 		if (rc < 0) {
- 			if (errno == EINTR)
+			if (errno == EINTR)
 				continue;
-			debug("slurm_send_timeout at %d of %zu, "
-				"send error: %s",
-				sent, size, strerror(errno));
- 			if (errno == EAGAIN) {	/* poll() lied to us */
+			debug("%s at %zu of %zu, send error: %s",
+			      __func__, sent, size, strerror(errno));
+			if (errno == EAGAIN) {	/* poll() lied to us */
 				usleep(10000);
 				continue;
 			}
- 			slurm_seterrno(SLURM_COMMUNICATIONS_SEND_ERROR);
-			sent = SLURM_ERROR;
+			slurm_seterrno(SLURM_COMMUNICATIONS_SEND_ERROR);
+			rc = SLURM_ERROR;
 			goto done;
 		}
 		if (rc == 0) {
-			debug("slurm_send_timeout at %d of %zu, "
-				"sent zero bytes", sent, size);
+			debug("%s at %zu of %zu, sent zero bytes",
+			      __func__, sent, size);
 			slurm_seterrno(SLURM_PROTOCOL_SOCKET_ZERO_BYTES_SENT);
-			sent = SLURM_ERROR;
+			rc = SLURM_ERROR;
 			goto done;
 		}
 
 		sent += rc;
+
+		/* Skip over what was sent for the next sendmsg() */
+		n = rc;
+		while (msg.msg_iovlen && (n >= msg.msg_iov->iov_len)) {
+			n -= msg.msg_iov->iov_len;
+			msg.msg_iov++;
+			msg.msg_iovlen--;
+		}
+		if (msg.msg_iovlen) {
+			msg.msg_iov->iov_base = (char *) msg.msg_iov->iov_base
+						+ n;
+			msg.msg_iov->iov_len -= n;
+		}
 	}
+	rc = sent;
 
     done:
 	/* Reset fd flags to prior state, preserve errno */
@@ -301,8 +349,20 @@ extern int slurm_send_timeout(int fd, char *buf, size_t size,
 		slurm_seterrno(slurm_err);
 	}
 
-	return sent;
+	return rc;
+}
+
+/* Send slurm message with timeout
+ * RET message size (as specified in argument) or SLURM_ERROR on error */
+extern int slurm_send_timeout(int fd, char *buf, size_t size,
+			      uint32_t flags, int timeout)
+{
+	struct iovec iov;
+
+	iov.iov_base = buf;
+	iov.iov_len = size;
 
+	return _send_iov_timeout(fd, &iov, 1, flags, timeout);
 }
 
 /* Get slurm message with timeout
@@ -43,6 +43,7 @@
 #include <assert.h>
 
 #include "src/common/log.h"
+#include "src/common/pack.h"
 #include "src/common/slurm_protocol_api.h"
 #include "src/common/slurm_protocol_defs.h"
 #include "src/common/slurm_protocol_util.h"
@@ -135,7 +136,12 @@ void init_header(header_t *header, slurm_msg_t *msg, uint16_t flags)
 		msg->protocol_version = header->version =
 			SLURM_PROTOCOL_VERSION;
 
-	header->flags = flags;
+	header->flags = flags & ~(SLURM_MSG_BORROW_BUFFER |
+				  SLURM_MSG_ACCEPT_LZ4 | SLURM_MSG_LZ4);
+	/* Let the peer compress a large response to us */
+	if ((header->version >= SLURM_19_05_PROTOCOL_VERSION) &&
+	    lz4_buf_enabled())
+		header->flags |= SLURM_MSG_ACCEPT_LZ4;
 	header->msg_type = msg->msg_type;
 	header->body_length = 0;	/* over-written later */
 	header->forward = msg->forward;
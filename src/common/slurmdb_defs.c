@@ -666,6 +666,7 @@ extern void slurmdb_destroy_assoc_usage(void *object)
 	if (usage) {
 		FREE_NULL_LIST(usage->children_list);
 		FREE_NULL_BITMAP(usage->valid_qos);
+		FREE_NULL_BITMAP(usage->limited_tres);
 		xfree(usage->grp_used_tres_run_secs);
 		xfree(usage->grp_used_tres);
 		xfree(usage->usage_tres_raw);
@@ -682,6 +683,7 @@ extern void slurmdb_destroy_qos_usage(void *object)
 		FREE_NULL_LIST(usage->acct_limit_list);
 		FREE_NULL_LIST(usage->job_list);
 		FREE_NULL_LIST(usage->user_limit_list);
+		FREE_NULL_BITMAP(usage->limited_tres);
 		xfree(usage->grp_used_tres_run_secs);
 		xfree(usage->grp_used_tres);
 		xfree(usage->usage_tres_raw);
@@ -2460,6 +2462,14 @@ extern void log_assoc_rec(slurmdb_assoc_rec_t *assoc_ptr,
 {
 	xassert(assoc_ptr);
 
+	/*
+	 * This is called for every association changed by a database update
+	 * while assoc_mgr holds its write locks, don't build the QOS strings
+	 * below unless they will be logged.
+	 */
+	if (get_log_level() < LOG_LEVEL_DEBUG2)
+		return;
+
 	debug2("association rec id : %u", assoc_ptr->id);
 	debug2("  acct             : %s", assoc_ptr->acct);
 	debug2("  cluster          : %s", assoc_ptr->cluster);
@@ -1938,7 +1938,7 @@ static void *_start_stage_out(void *x)
 		} else {
 			job_ptr->job_state &= (~JOB_STAGE_OUT);
 			xfree(job_ptr->state_desc);
-			last_job_update = time(NULL);
+			set_job_last_update(job_ptr, time(NULL));
 		}
 		slurm_mutex_lock(&bb_state.bb_mutex);
 		bb_job = _get_bb_job(job_ptr);
@@ -4006,7 +4006,7 @@ fini:
 /* Kill job from CONFIGURING state */
 static void _kill_job(struct job_record *job_ptr, bool hold_job)
 {
-	last_job_update = time(NULL);
+	set_job_last_update(job_ptr, time(NULL));
 	job_ptr->end_time = last_job_update;
 	if (hold_job)
 		job_ptr->priority = 0;
@@ -2563,6 +2563,7 @@ static int _update_node_state(char *node_list, bool set_locks)
 						      mcdram_cfg,mcdram_cfg_cnt,
 						      numa_cap, numa_cap_cnt,
 						      numa_cfg, numa_cfg_cnt);
+				set_node_last_update(node_ptr, time(NULL));
 			}
 			free(node_name);
 		}
@@ -2573,6 +2574,7 @@ static int _update_node_state(char *node_list, bool set_locks)
 		time_t now = time(NULL);
 		for (i = 0, node_ptr = node_record_table_ptr;
 		     i < node_record_count; i++, node_ptr++) {
+			set_node_last_update(node_ptr, now);
 			if (node_ptr->last_response > now) {
 				/*
 				 * Reboot likely in progress.
@@ -158,6 +158,48 @@ static int _cmp_level_fs(const void *x,
 	return (*a)->user ? -1 : 1;
 }
 
+/* Returns true if the siblings are already in _cmp_level_fs order */
+static bool _level_fs_sorted(slurmdb_assoc_rec_t **siblings, size_t count)
+{
+	size_t i;
+
+	for (i = 1; i < count; i++) {
+		if (_cmp_level_fs(&siblings[i - 1], &siblings[i]) > 0)
+			return false;
+	}
+	return true;
+}
+
+/* Sort siblings by level_fs. If the siblings array was built from a single
+ * children list, that list is kept in the same order so the next pass finds
+ * it already sorted unless usage below it changed.
+ * IN/OUT siblings - null terminated array of siblings
+ * IN count - number of siblings in the array
+ * IN/OUT order_list - list siblings was built from, or NULL if merged
+ */
+static void _sort_level_fs(slurmdb_assoc_rec_t **siblings, size_t count,
+			   List order_list)
+{
+	ListIterator itr;
+	slurmdb_assoc_rec_t *assoc;
+	size_t i = 0;
+
+	if (_level_fs_sorted(siblings, count))
+		return;
+
+	if (!order_list) {
+		qsort(siblings, count, sizeof(slurmdb_assoc_rec_t *),
+		      _cmp_level_fs);
+		return;
+	}
+
+	list_sort(order_list, (ListCmpF) _cmp_level_fs);
+	itr = list_iterator_create(order_list);
+	while ((assoc = list_next(itr)) && (i < count))
+		siblings[i++] = assoc;
+	list_iterator_destroy(itr);
+}
+
 
 /* Calculate LF = S / U for an association.
  *
@@ -310,15 +352,21 @@ static slurmdb_assoc_rec_t** _merge_accounts(
  *	3) A user with the same level_fs as a sibling account will receive
  *	   the same rank as the account's highest ranked user
  *
+ * Decay scales the usage of every association by the same factor, so the
+ * order of siblings only changes when usage was added somewhere below one of
+ * them. Sibling lists are kept sorted between passes and only re-sorted when
+ * their order changed.
+ *
  * IN siblings - array of siblings
+ * IN order_list - children list siblings was built from, NULL if merged
  * IN assoc_level - depth in the tree (root is 0)
  * IN/OUT rank - current user ranking, starting at g_user_assoc_count
  * IN/OUT rnt - rank, no ties (what rank would be if no tie exists)
  * IN account_tied - is this account tied with the previous user
  */
 static void _calc_tree_fs(slurmdb_assoc_rec_t** siblings,
-			  uint16_t assoc_level, uint32_t *rank,
-			  uint32_t *rnt, bool account_tied)
+			  List order_list, uint16_t assoc_level,
+			  uint32_t *rank, uint32_t *rnt, bool account_tied)
 {
 	slurmdb_assoc_rec_t *assoc = NULL;
 	long double prev_level_fs = (long double) NO_VAL;
@@ -330,7 +378,7 @@ static void _calc_tree_fs(slurmdb_assoc_rec_t** siblings,
 		_calc_assoc_fs(assoc);
 
 	/* Sort children by level_fs */
-	qsort(siblings, i, sizeof(slurmdb_assoc_rec_t *), _cmp_level_fs);
+	_sort_level_fs(siblings, i, order_list);
 
 	/* Iterate through children in sorted order. If it's a user, calculate
 	 * fs_factor, otherwise recurse. */
@@ -370,8 +418,10 @@ static void _calc_tree_fs(slurmdb_assoc_rec_t** siblings,
 						   i + merge_count,
 						   assoc_level);
 
-			_calc_tree_fs(children, assoc_level+1,
-				      rank, rnt, tied);
+			_calc_tree_fs(children,
+				      merge_count ? NULL :
+				      assoc->usage->children_list,
+				      assoc_level+1, rank, rnt, tied);
 
 			/* Skip over any merged accounts */
 			i += merge_count;
@@ -403,7 +453,8 @@ static void _apply_priority_fs(void)
 		children,
 		&child_count);
 
-	_calc_tree_fs(children, 0, &rank, &rnt, false);
+	_calc_tree_fs(children, assoc_mgr_root_assoc->usage->children_list,
+		      0, &rank, &rnt, false);
 
 	xfree(children);
 }
@@ -1990,7 +1990,11 @@ extern int decay_apply_weighted_factors(struct job_record *job_ptr,
 	if (((flags & PRIORITY_FLAGS_INCR_ONLY) == 0) ||
 	    (job_ptr->priority < new_prio)) {
 		job_ptr->priority = new_prio;
-		last_job_update = time(NULL);
+		/*
+		 * set_job_last_update() is not used here since this
+		 * plugin is also linked without the slurmctld (see above)
+		 */
+		job_ptr->last_update = last_job_update = time(NULL);
 	}
 
 	debug2("priority for job %u is now %u",
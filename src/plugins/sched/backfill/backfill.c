@@ -976,6 +976,25 @@ static int _yield_locks(int usec)
 	node_update = last_node_update;
 	part_update = last_part_update;
 
+	/*
+	 * If no other thread is blocked on our locks there is nobody to
+	 * yield to. Keep the locks and continue testing rather than sleep;
+	 * no job, node or partition state can change while we hold them.
+	 */
+	if (!lock_slurmctld_contended(all_locks) &&
+	    ((defer_rpc_cnt == 0) ||
+	     (slurmctld_config.server_thread_count <= max_rpc_cnt))) {
+		if (debug_flags & DEBUG_FLAG_BACKFILL)
+			info("backfill: no lock contention, not yielding");
+		slurm_mutex_lock(&config_lock);
+		if (config_flag)
+			load_config = true;
+		slurm_mutex_unlock(&config_lock);
+		if (stop_backfill || load_config)
+			return 1;
+		return 0;
+	}
+
 	unlock_slurmctld(all_locks);
 	while (!stop_backfill) {
 		bf_sleep_usec += _my_sleep(usec);
@@ -1089,7 +1108,9 @@ static int _attempt_backfill(void)
 	bitstr_t *exc_core_bitmap = NULL, *resv_bitmap = NULL;
 	time_t now, sched_start, later_start, start_res, resv_end, window_end;
 	time_t pack_time, orig_sched_start, orig_start_time = (time_t) 0;
+	time_t ns_start_res = 0;
 	node_space_map_t *node_space;
+	int ns_first = 0;
 	user_part_rec_t *bf_user_part_ptr = NULL;
 	struct timeval bf_time1, bf_time2;
 	int rc = 0, error_code;
@@ -1335,7 +1356,7 @@ static int _attempt_backfill(void)
 				job_ptr->state_reason = WAIT_NO_REASON;
 				xfree(job_ptr->state_desc);
 				job_ptr->assoc_id = assoc_rec.id;
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 			} else {
 				debug("backfill: %pJ has invalid association",
 				      job_ptr);
@@ -1362,13 +1383,13 @@ static int _attempt_backfill(void)
 				      job_ptr);
 				xfree(job_ptr->state_desc);
 				job_ptr->state_reason = FAIL_QOS;
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 				assoc_mgr_unlock(&locks);
 				continue;
 			} else if (job_ptr->state_reason == FAIL_QOS) {
 				xfree(job_ptr->state_desc);
 				job_ptr->state_reason = WAIT_NO_REASON;
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 			}
 			assoc_mgr_unlock(&locks);
 		}
@@ -1710,6 +1731,8 @@ next_task:
 			time_limit = job_ptr->time_limit = job_ptr->time_min;
 
 		later_start = now;
+		ns_first = 0;
+		ns_start_res = 0;
 
 		if (assoc_limit_stop) {
 			if (qos_blocked_until > later_start) {
@@ -1821,13 +1844,23 @@ next_task:
 		bit_and_not(avail_bitmap, bf_ignore_node_bitmap);
 		filter_by_node_owner(job_ptr, avail_bitmap);
 		filter_by_node_mcs(job_ptr, mcs_select, avail_bitmap);
-		for (j = 0; ; ) {
+		/*
+		 * Each retry of this job at a later start_res would walk past
+		 * the same leading records again. Resume from the first record
+		 * ending after the previous start_res instead; node_space is
+		 * not modified until the job has been placed.
+		 */
+		if (start_res < ns_start_res)
+			ns_first = 0;
+		ns_start_res = start_res;
+		for (j = ns_first; ; ) {
 			if ((node_space[j].end_time > start_res) &&
 			     node_space[j].next && (later_start == 0))
 				later_start = node_space[j].end_time;
-			if (node_space[j].end_time <= start_res)
-				;
-			else if (node_space[j].begin_time <= end_time) {
+			if (node_space[j].end_time <= start_res) {
+				if (node_space[j].next)
+					ns_first = node_space[j].next;
+			} else if (node_space[j].begin_time <= end_time) {
 				bit_and(avail_bitmap,
 					node_space[j].avail_bitmap);
 			} else
@@ -1942,7 +1975,9 @@ next_task:
 			orig_end_time = end_time;
 			end_time += boot_time;
 
-			for (j = 0; ; ) {
+			if (start_res < ns_start_res)
+				ns_first = 0;
+			for (j = ns_first; ; ) {
 				if (node_space[j].end_time <= start_res)
 					;
 				else if (node_space[j].begin_time <= end_time) {
@@ -1985,15 +2020,15 @@ next_task:
 
 		if (start_res > job_ptr->start_time) {
 			job_ptr->start_time = start_res;
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 		}
 		/*
 		 * avail_bitmap at this point contains a bitmap of nodes
 		 * selected for this job to be allocated
 		 */
 		if ((job_ptr->start_time <= now) &&
-		    (bit_overlap(avail_bitmap, cg_node_bitmap) ||
-		     bit_overlap(avail_bitmap, rs_node_bitmap))) {
+		    (bit_overlap_any(avail_bitmap, cg_node_bitmap) ||
+		     bit_overlap_any(avail_bitmap, rs_node_bitmap))) {
 			/* Need to wait for in-progress completion/epilog */
 			job_ptr->start_time = now + 1;
 			later_start = 0;
@@ -2018,7 +2053,7 @@ next_task:
 				     job_state_string(job_ptr->job_state),
 				     job_reason_string(job_ptr->state_reason),
 				     job_ptr->priority);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			_set_job_time_limit(job_ptr, orig_time_limit);
 			later_start = 0;
 			if (bb == -1)
@@ -2480,7 +2515,7 @@ static int _start_job(struct job_record *job_ptr, bitstr_t *resv_bitmap)
 		FREE_NULL_BITMAP(orig_exc_nodes);
 	if (rc == SLURM_SUCCESS) {
 		/* job initiated */
-		last_job_update = time(NULL);
+		set_job_last_update(job_ptr, time(NULL));
 		info("backfill: Started %pJ in %s on %s",
 		     job_ptr, job_ptr->part_ptr->name, job_ptr->nodes);
 		power_g_job_start(job_ptr);
@@ -2682,12 +2717,19 @@ static void _add_reservation(uint32_t start_time, uint32_t end_reserve,
 			break;
 	}
 
-	/* Drop records with identical bitmaps (up to one record).
-	 * This can significantly improve performance of the backfill tests. */
+	/*
+	 * Drop records with identical bitmaps. This can significantly improve
+	 * performance of the backfill tests. Only records changed above can
+	 * have become identical to a neighbour, so compare just the pairs
+	 * which include one of them and merge every match found there.
+	 */
 	for (i = 0; ; ) {
 		if ((j = node_space[i].next) == 0)
 			break;
-		if (!bit_equal(node_space[i].avail_bitmap,
+		if (node_space[i].begin_time >= end_reserve)
+			break;
+		if ((node_space[j].begin_time < start_time) ||
+		    !bit_equal(node_space[i].avail_bitmap,
 			       node_space[j].avail_bitmap)) {
 			i = j;
 			continue;
@@ -2695,7 +2737,6 @@ static void _add_reservation(uint32_t start_time, uint32_t end_reserve,
 		node_space[i].end_time = node_space[j].end_time;
 		node_space[i].next = node_space[j].next;
 		FREE_NULL_BITMAP(node_space[j].avail_bitmap);
-		break;
 	}
 }
 
@@ -2853,11 +2894,11 @@ static time_t _pack_start_find(struct job_record *job_ptr, time_t now)
 		if (job_ptr->details->begin_time <= now) {
 			if (job_ptr->state_reason == WAIT_TIME) {
 				job_ptr->state_reason = WAIT_NO_REASON;
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 			}
 			if (job_ptr->state_reason_prev == WAIT_TIME) {
 				job_ptr->state_reason_prev = WAIT_NO_REASON;
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 			}
 		}
 
@@ -3205,7 +3246,7 @@ static void _pack_kill_now(pack_job_map_t *map)
 		job_ptr->details->begin_time = now + cred_lifetime + 1;
 		job_ptr->end_time   = now;
 		job_ptr->job_state  = JOB_PENDING | JOB_COMPLETING;
-		last_job_update     = now;
+		set_job_last_update(job_ptr, now);
 		build_cg_bitmap(job_ptr);
 		job_completion_logger(job_ptr, false);
 		deallocate_nodes(job_ptr, false, false, false);
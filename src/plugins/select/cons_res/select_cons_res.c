@@ -342,7 +342,11 @@ static struct part_row_data *_dup_row_data(struct part_row_data *orig_row,
 }
 
 
-/* Create a duplicate part_res_record list */
+/*
+ * Create a duplicate part_res_record list. The row data is shared with
+ * orig_ptr until _rm_job_from_res() modifies a partition's rows, so orig_ptr
+ * must not change while the copy is in use.
+ */
 static struct part_res_record *_dup_part_data(struct part_res_record *orig_ptr)
 {
 	struct part_res_record *new_part_ptr, *new_ptr;
@@ -356,8 +360,8 @@ static struct part_res_record *_dup_part_data(struct part_res_record *orig_ptr)
 	while (orig_ptr) {
 		new_ptr->part_ptr = orig_ptr->part_ptr;
 		new_ptr->num_rows = orig_ptr->num_rows;
-		new_ptr->row = _dup_row_data(orig_ptr->row,
-					     orig_ptr->num_rows);
+		new_ptr->row = orig_ptr->row;
+		new_ptr->row_shared = (orig_ptr->row != NULL);
 		if (orig_ptr->next) {
 			new_ptr->next = xmalloc(sizeof(struct part_res_record));
 			new_ptr = new_ptr->next;
@@ -368,11 +372,14 @@ static struct part_res_record *_dup_part_data(struct part_res_record *orig_ptr)
 }
 
 
-/* Create a duplicate part_res_record list */
+/*
+ * Create a duplicate node_use_record array. A node's GRES state is not
+ * copied until _rm_job_from_res() modifies it, until then the copy uses the
+ * node's own gres_list just as select_node_usage does.
+ */
 static struct node_use_record *_dup_node_usage(struct node_use_record *orig_ptr)
 {
 	struct node_use_record *new_use_ptr, *new_ptr;
-	List gres_list;
 	uint32_t i;
 
 	if (orig_ptr == NULL)
@@ -384,11 +391,11 @@ static struct node_use_record *_dup_node_usage(struct node_use_record *orig_ptr)
 	for (i = 0; i < select_node_cnt; i++) {
 		new_ptr[i].node_state   = orig_ptr[i].node_state;
 		new_ptr[i].alloc_memory = orig_ptr[i].alloc_memory;
-		if (orig_ptr[i].gres_list)
-			gres_list = orig_ptr[i].gres_list;
-		else
-			gres_list = node_record_table_ptr[i].gres_list;
-		new_ptr[i].gres_list = gres_plugin_node_state_dup(gres_list);
+		if (orig_ptr[i].gres_list) {
+			new_ptr[i].gres_list =
+				gres_plugin_node_state_dup(
+					orig_ptr[i].gres_list);
+		}
 	}
 	return new_use_ptr;
 }
@@ -411,7 +418,7 @@ static void _destroy_part_data(struct part_res_record *this_ptr)
 		this_ptr = this_ptr->next;
 		tmp->part_ptr = NULL;
 
-		if (tmp->row) {
+		if (tmp->row && !tmp->row_shared) {
 			_destroy_row_data(tmp->row, tmp->num_rows);
 			tmp->row = NULL;
 		}
@@ -579,6 +586,17 @@ extern void cr_sort_part_rows(struct part_res_record *p_ptr)
 		else
 			a[i] = 0;
 	}
+	for (i = 1; i < p_ptr->num_rows; i++) {
+		if (a[i] > a[i - 1])
+			break;
+	}
+	if (i >= p_ptr->num_rows)	/* Already sorted */
+		return;
+	if (p_ptr->row_shared) {
+		/* State copy, don't reorder the original's rows */
+		p_ptr->row = _dup_row_data(p_ptr->row, p_ptr->num_rows);
+		p_ptr->row_shared = false;
+	}
 	for (i = 0; i < p_ptr->num_rows; i++) {
 		for (j = i+1; j < p_ptr->num_rows; j++) {
 			if (a[j] > a[i]) {
@@ -1219,6 +1237,13 @@ static int _rm_job_from_res(struct part_res_record *part_record_ptr,
 
 		node_ptr = node_record_table_ptr + i;
 		if (action != 2) {
+			if (!node_usage[i].gres_list &&
+			    (node_usage != select_node_usage)) {
+				/* State copy, see _dup_node_usage() */
+				node_usage[i].gres_list =
+					gres_plugin_node_state_dup(
+						node_ptr->gres_list);
+			}
 			if (node_usage[i].gres_list)
 				gres_list = node_usage[i].gres_list;
 			else
@@ -1272,6 +1297,12 @@ static int _rm_job_from_res(struct part_res_record *part_record_ptr,
 
 		if (!p_ptr->row)
 			return SLURM_SUCCESS;
+		if (p_ptr->row_shared) {
+			/* State copy, see _dup_part_data() */
+			p_ptr->row = _dup_row_data(p_ptr->row,
+						   p_ptr->num_rows);
+			p_ptr->row_shared = false;
+		}
 
 		/* remove the job from the job_list */
 		n = 0;
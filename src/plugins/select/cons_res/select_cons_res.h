@@ -79,6 +79,9 @@ struct part_res_record {
 	uint16_t num_rows;		/* Number of elements in "row" array */
 	struct part_record *part_ptr;   /* controller part record pointer */
 	struct part_row_data *row;	/* array of rows containing jobs */
+	bool row_shared;		/* "row" belongs to the record this
+					 * one was copied from, duplicate it
+					 * before modifying */
 };
 
 /* per-node resource data */
@@ -99,8 +102,10 @@ struct node_res_record {
 struct node_use_record {
 	uint64_t alloc_memory;		/* real memory reserved by already
 					 * scheduled jobs */
-	List gres_list;			/* list of gres state info managed by 
-					 * plugins */
+	List gres_list;			/* list of gres state info managed by
+					 * plugins. Set only in a state copy
+					 * which has modified the node's GRES,
+					 * otherwise use node_ptr->gres_list */
 	uint16_t node_state;		/* see node_cr_state comments */
 };
 
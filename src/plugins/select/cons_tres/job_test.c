@@ -98,8 +98,6 @@ static int _cr_job_list_sort(void *x, void *y);
 static struct node_use_record *_dup_node_usage(
 					struct node_use_record *orig_ptr);
 static struct part_res_record *_dup_part_data(struct part_res_record *orig_ptr);
-static struct part_row_data *_dup_row_data(struct part_row_data *orig_row,
-					   uint16_t num_rows);
 static bool _enough_nodes(int avail_nodes, int rem_nodes,
 			  uint32_t min_nodes, uint32_t req_nodes);
 static int _eval_nodes(struct job_record *job_ptr, gres_mc_data_t *mc_ptr,
@@ -583,6 +581,13 @@ extern int rm_job_res(struct part_res_record *part_record_ptr,
 
 		node_ptr = node_record_table_ptr + i;
 		if (action != 2) {
+			if (!node_usage[i].gres_list &&
+			    (node_usage != select_node_usage)) {
+				/* State copy, see _dup_node_usage() */
+				node_usage[i].gres_list =
+					gres_plugin_node_state_dup(
+						node_ptr->gres_list);
+			}
 			if (node_usage[i].gres_list)
 				gres_list = node_usage[i].gres_list;
 			else
@@ -640,6 +645,12 @@ extern int rm_job_res(struct part_res_record *part_record_ptr,
 
 		if (!p_ptr->row)
 			return SLURM_SUCCESS;
+		if (p_ptr->row_shared) {
+			/* State copy, see _dup_part_data() */
+			p_ptr->row = dup_row_data(p_ptr->row,
+						  p_ptr->num_rows);
+			p_ptr->row_shared = false;
+		}
 
 		/* remove the job from the job_list */
 		n = 0;
@@ -748,7 +759,8 @@ extern void build_row_bitmaps(struct part_res_record *p_ptr,
 		num_jobs += p_ptr->row[i].num_jobs;
 	}
 	if (num_jobs == 0) {
-		clear_core_array(p_ptr->row[i].row_bitmap);
+		for (i = 0; i < p_ptr->num_rows; i++)
+			clear_core_array(p_ptr->row[i].row_bitmap);
 		return;
 	}
 
@@ -758,10 +770,22 @@ extern void build_row_bitmaps(struct part_res_record *p_ptr,
 	}
 	debug3("%s: %s reshuffling %u jobs", plugin_type, __func__, num_jobs);
 
-	/* make a copy, in case we cannot do better than this */
-	orig_row = _dup_row_data(p_ptr->row, p_ptr->num_rows);
-	if (orig_row == NULL)
-		return;
+	/*
+	 * Save the job lists, in case we cannot do better than this. The
+	 * row bitmaps are rebuilt from the job lists in either case, so
+	 * there is no need to copy them.
+	 */
+	orig_row = xmalloc(p_ptr->num_rows * sizeof(struct part_row_data));
+	for (i = 0; i < p_ptr->num_rows; i++) {
+		orig_row[i].num_jobs = p_ptr->row[i].num_jobs;
+		orig_row[i].job_list_size = p_ptr->row[i].job_list_size;
+		if (orig_row[i].job_list_size == 0)
+			continue;
+		orig_row[i].job_list = xmalloc(orig_row[i].job_list_size *
+					       sizeof(struct job_resources *));
+		memcpy(orig_row[i].job_list, p_ptr->row[i].job_list,
+		       (sizeof(struct job_resources *) * orig_row[i].num_jobs));
+	}
 
 	/* create a master job list and clear out ALL row data */
 	ss = xmalloc(num_jobs * sizeof(struct sort_support));
@@ -840,9 +864,13 @@ extern void build_row_bitmaps(struct part_res_record *p_ptr,
 			dump_parts(p_ptr);
 		}
 
-		cr_destroy_row_data(p_ptr->row, p_ptr->num_rows);
-		p_ptr->row = orig_row;
-		orig_row = NULL;
+		for (i = 0; i < p_ptr->num_rows; i++) {
+			xfree(p_ptr->row[i].job_list);
+			p_ptr->row[i].job_list = orig_row[i].job_list;
+			p_ptr->row[i].job_list_size = orig_row[i].job_list_size;
+			p_ptr->row[i].num_jobs = orig_row[i].num_jobs;
+			orig_row[i].job_list = NULL;
+		}
 
 		/* still need to rebuild row_bitmaps */
 		for (i = 0; i < p_ptr->num_rows; i++) {
@@ -861,8 +889,7 @@ extern void build_row_bitmaps(struct part_res_record *p_ptr,
 		dump_parts(p_ptr);
 	}
 
-	if (orig_row)
-		cr_destroy_row_data(orig_row, p_ptr->num_rows);
+	cr_destroy_row_data(orig_row, p_ptr->num_rows);
 	xfree(ss);
 
 	return;
@@ -952,11 +979,14 @@ extern int vpus_per_core(struct job_details *details, int node_inx)
 	return vpus_per_core;
 }
 
-/* Create a duplicate part_res_record list */
+/*
+ * Create a duplicate node_use_record array. A node's GRES state is not
+ * copied until rm_job_res() modifies it, until then the copy uses the
+ * node's own gres_list just as select_node_usage does.
+ */
 static struct node_use_record *_dup_node_usage(struct node_use_record *orig_ptr)
 {
 	struct node_use_record *new_use_ptr, *new_ptr;
-	List gres_list;
 	uint32_t i;
 
 	if (orig_ptr == NULL)
@@ -968,16 +998,20 @@ static struct node_use_record *_dup_node_usage(struct node_use_record *orig_ptr)
 	for (i = 0; i < select_node_cnt; i++) {
 		new_ptr[i].node_state   = orig_ptr[i].node_state;
 		new_ptr[i].alloc_memory = orig_ptr[i].alloc_memory;
-		if (orig_ptr[i].gres_list)
-			gres_list = orig_ptr[i].gres_list;
-		else
-			gres_list = node_record_table_ptr[i].gres_list;
-		new_ptr[i].gres_list = gres_plugin_node_state_dup(gres_list);
+		if (orig_ptr[i].gres_list) {
+			new_ptr[i].gres_list =
+				gres_plugin_node_state_dup(
+					orig_ptr[i].gres_list);
+		}
 	}
 	return new_use_ptr;
 }
 
-/* Create a duplicate part_res_record list */
+/*
+ * Create a duplicate part_res_record list. The row data is shared with
+ * orig_ptr until rm_job_res() modifies a partition's rows, so orig_ptr must
+ * not change while the copy is in use.
+ */
 static struct part_res_record *_dup_part_data(struct part_res_record *orig_ptr)
 {
 	struct part_res_record *new_part_ptr, *new_ptr;
@@ -991,8 +1025,8 @@ static struct part_res_record *_dup_part_data(struct part_res_record *orig_ptr)
 	while (orig_ptr) {
 		new_ptr->part_ptr = orig_ptr->part_ptr;
 		new_ptr->num_rows = orig_ptr->num_rows;
-		new_ptr->row = _dup_row_data(orig_ptr->row,
-					     orig_ptr->num_rows);
+		new_ptr->row = orig_ptr->row;
+		new_ptr->row_shared = (orig_ptr->row != NULL);
 		if (orig_ptr->next) {
 			new_ptr->next = xmalloc(sizeof(struct part_res_record));
 			new_ptr = new_ptr->next;
@@ -1002,9 +1036,9 @@ static struct part_res_record *_dup_part_data(struct part_res_record *orig_ptr)
 	return new_part_ptr;
 }
 
-/* Helper function for _dup_part_data: create a duplicate part_row_data array */
-static struct part_row_data *_dup_row_data(struct part_row_data *orig_row,
-					   uint16_t num_rows)
+/* Create a duplicate part_row_data array */
+extern struct part_row_data *dup_row_data(struct part_row_data *orig_row,
+					  uint16_t num_rows)
 {
 	struct part_row_data *new_row;
 	int i, n;
@@ -1065,7 +1099,7 @@ extern int job_fit_test(job_resources_t *job_resrcs_ptr,
 		if (job_resrcs_ptr->whole_node) {
 			if (!sys_resrcs_ptr[i] ||
 			    bit_ffs(sys_resrcs_ptr[i]) == -1)
-				return 1;	/* Success */
+				continue;
 			return 0;		/* Whole node conflict */
 		}
 		rep_offset++;
@@ -1075,6 +1109,11 @@ extern int job_fit_test(job_resources_t *job_resrcs_ptr,
 		}
 		c_job = job_resrcs_ptr->sockets_per_node[rep_inx] *
 			job_resrcs_ptr->cores_per_socket[rep_inx];
+		/* No cores in use on this node, skip testing them one by one */
+		if (!sys_resrcs_ptr[i] || (bit_ffs(sys_resrcs_ptr[i]) == -1)) {
+			c_off += c_job;
+			continue;
+		}
 		c_max = MIN(select_node_record[i].tot_cores, c_job);
 		for (c = 0; c < c_max; c++) {
 			if (!bit_test(job_resrcs_ptr->core_bitmap, c_off + c))
@@ -3563,7 +3602,7 @@ static int _eval_nodes_dfly(struct job_record *job_ptr,
 	     i++, switch_ptr++) {
 		switch_node_bitmap[i] = bit_copy(switch_ptr->node_bitmap);
 		if (req_nodes_bitmap &&
-		    bit_overlap(req_nodes_bitmap, switch_node_bitmap[i])) {
+		    bit_overlap_any(req_nodes_bitmap, switch_node_bitmap[i])) {
 			switch_required[i] = 1;
 			if (switch_record_table[i].level == 0) {
 				leaf_switch_count++;
@@ -3576,7 +3615,7 @@ static int _eval_nodes_dfly(struct job_record *job_ptr,
 			}
 		}
 		if (!req_nodes_bitmap &&
-		    bit_overlap(nw->node_bitmap, switch_node_bitmap[i])) {
+		    bit_overlap_any(nw->node_bitmap, switch_node_bitmap[i])) {
 			if ((top_switch_inx == -1) ||
 			    (switch_record_table[i].level >
 			     switch_record_table[top_switch_inx].level)) {
@@ -3735,8 +3774,8 @@ static int _eval_nodes_dfly(struct job_record *job_ptr,
 		     i < switch_record_cnt; i++, switch_ptr++) {
 			if (switch_required[i])
 				continue;
-			if (bit_overlap(req2_nodes_bitmap,
-					switch_node_bitmap[i])) {
+			if (bit_overlap_any(req2_nodes_bitmap,
+					    switch_node_bitmap[i])) {
 				switch_required[i] = 1;
 				if (switch_record_table[i].level == 0) {
 					leaf_switch_count++;
@@ -3780,9 +3819,9 @@ static int _eval_nodes_dfly(struct job_record *job_ptr,
 	avail_nodes_bitmap = bit_alloc(node_record_count);
 	for (i = 0, switch_ptr = switch_record_table; i < switch_record_cnt;
 	     i++, switch_ptr++) {
-		bit_and(switch_node_bitmap[i], best_nodes_bitmap);
+		switch_node_cnt[i] = bit_and_set_count(switch_node_bitmap[i],
+						       best_nodes_bitmap);
 		bit_or(avail_nodes_bitmap, switch_node_bitmap[i]);
-		switch_node_cnt[i] = bit_set_count(switch_node_bitmap[i]);
 	}
 
 	if (select_debug_flags & DEBUG_FLAG_SELECT_TYPE) {
@@ -4195,7 +4234,7 @@ static int _eval_nodes_topo(struct job_record *job_ptr,
 	     i++, switch_ptr++) {
 		switch_node_bitmap[i] = bit_copy(switch_ptr->node_bitmap);
 		if (req_nodes_bitmap &&
-		    bit_overlap(req_nodes_bitmap, switch_node_bitmap[i])) {
+		    bit_overlap_any(req_nodes_bitmap, switch_node_bitmap[i])) {
 			switch_required[i] = 1;
 			if (switch_record_table[i].level == 0) {
 				leaf_switch_count++;
@@ -4208,7 +4247,7 @@ static int _eval_nodes_topo(struct job_record *job_ptr,
 			}
 		}
 		if (!req_nodes_bitmap &&
-		    bit_overlap(nw->node_bitmap, switch_node_bitmap[i])) {
+		    bit_overlap_any(nw->node_bitmap, switch_node_bitmap[i])) {
 			if ((top_switch_inx == -1) ||
 			    (switch_record_table[i].level >
 			     switch_record_table[top_switch_inx].level)) {
@@ -4367,8 +4406,8 @@ static int _eval_nodes_topo(struct job_record *job_ptr,
 		     i < switch_record_cnt; i++, switch_ptr++) {
 			if (switch_required[i])
 				continue;
-			if (bit_overlap(req2_nodes_bitmap,
-					switch_node_bitmap[i])) {
+			if (bit_overlap_any(req2_nodes_bitmap,
+					    switch_node_bitmap[i])) {
 				switch_required[i] = 1;
 				if (switch_record_table[i].level == 0) {
 					leaf_switch_count++;
@@ -4413,9 +4452,9 @@ static int _eval_nodes_topo(struct job_record *job_ptr,
 	avail_nodes_bitmap = bit_alloc(node_record_count);
 	for (i = 0, switch_ptr = switch_record_table; i < switch_record_cnt;
 	     i++, switch_ptr++) {
-		bit_and(switch_node_bitmap[i], best_nodes_bitmap);
+		switch_node_cnt[i] = bit_and_set_count(switch_node_bitmap[i],
+						       best_nodes_bitmap);
 		bit_or(avail_nodes_bitmap, switch_node_bitmap[i]);
-		switch_node_cnt[i] = bit_set_count(switch_node_bitmap[i]);
 	}
 
 	if (select_debug_flags & DEBUG_FLAG_SELECT_TYPE) {
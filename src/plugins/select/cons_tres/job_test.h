@@ -113,6 +113,10 @@ extern void core_array_and_not(bitstr_t **core_array1, bitstr_t **core_array2);
  */
 extern void core_array_or(bitstr_t **core_array1, bitstr_t **core_array2);
 
+/* Create a duplicate part_row_data array */
+extern struct part_row_data *dup_row_data(struct part_row_data *orig_row,
+					  uint16_t num_rows);
+
 /* Free an array of bitmaps, one per node */
 extern void free_core_array(bitstr_t ***core_array);
 
@@ -2674,7 +2674,7 @@ extern void cr_destroy_part_data(struct part_res_record *this_ptr)
 		this_ptr = this_ptr->next;
 		tmp->part_ptr = NULL;
 
-		if (tmp->row) {
+		if (tmp->row && !tmp->row_shared) {
 			cr_destroy_row_data(tmp->row, tmp->num_rows);
 			tmp->row = NULL;
 		}
@@ -2762,6 +2762,19 @@ extern void cr_sort_part_rows(struct part_res_record *p_ptr)
 			a[r] += bit_set_count(p_ptr->row[r].row_bitmap[n]);
 		}
 	}
+	for (r = 1; r < p_ptr->num_rows; r++) {
+		if (a[r] > a[r - 1])
+			break;
+	}
+	if (r >= p_ptr->num_rows) {	/* Already sorted */
+		xfree(a);
+		return;
+	}
+	if (p_ptr->row_shared) {
+		/* State copy, don't reorder the original's rows */
+		p_ptr->row = dup_row_data(p_ptr->row, p_ptr->num_rows);
+		p_ptr->row_shared = false;
+	}
 	for (i = 0; i < p_ptr->num_rows; i++) {
 		for (j = i + 1; j < p_ptr->num_rows; j++) {
 			if (a[j] > a[i]) {
@@ -89,7 +89,9 @@ struct node_use_record {
 	List gres_list;			/* list of gres_node_state_t records as
 					 * defined in in src/common/gres.h.
 					 * Local data used only in state copy
-					 * to emulate future node state */
+					 * to emulate future node state. Set
+					 * there only once the copy modifies
+					 * the node's GRES */
 	uint16_t node_state;		/* see node_cr_state comments */
 };
 
@@ -108,6 +110,9 @@ struct part_res_record {
 	uint16_t num_rows;		/* Number of elements in "row" array */
 	struct part_record *part_ptr;   /* controller part record pointer */
 	struct part_row_data *row;	/* array of rows containing jobs */
+	bool row_shared;		/* "row" belongs to the record this
+					 * one was copied from, duplicate it
+					 * before modifying */
 };
 
 /* Global variables */
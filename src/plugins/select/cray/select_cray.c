@@ -2332,10 +2332,13 @@ extern int select_p_select_nodeinfo_set_all(void)
 	/* clear all marks */
 	for (i=0; i<node_record_count; i++) {
 		struct node_record *node_ptr = &(node_record_table_ptr[i]);
+		uint32_t node_state = node_ptr->node_state;
 		if (bit_test(blade_nodes_running_npc, i))
 			node_ptr->node_state |= NODE_STATE_NET;
 		else
 			node_ptr->node_state &= (~NODE_STATE_NET);
+		if (node_ptr->node_state != node_state)
+			set_node_last_update(node_ptr, last_node_update);
 	}
 
 	slurm_mutex_unlock(&blade_mutex);
@@ -57,6 +57,8 @@ scontrol_load_job(job_info_msg_t ** job_buffer_pptr, uint32_t job_id)
 	uint16_t show_flags = 0;
 	job_info_msg_t * job_info_ptr = NULL;
 
+	/* Job records are only read here, so their strings need not be copied */
+	show_flags |= SHOW_NO_COPY;
 	if (all_flag)
 		show_flags |= SHOW_ALL;
 
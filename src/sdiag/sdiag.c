@@ -100,6 +100,17 @@ int main(int argc, char **argv)
 	exit(rc);
 }
 
+static const char *_lock_type_name(int inx)
+{
+	static const char *lock_names[] = {
+		"Config", "Job", "Node", "Partition", "Federation"
+	};
+
+	if ((inx >= 0) && (inx < (sizeof(lock_names) / sizeof(char *))))
+		return lock_names[inx];
+	return "Unknown";
+}
+
 static int _print_stats(void)
 {
 	int i;
@@ -187,6 +198,35 @@ static int _print_stats(void)
 	printf("\nLatency for 1000 calls to gettimeofday(): %d microseconds\n",
 	       buf->gettimeofday_latency);
 
+	if (buf->lock_type_count) {
+		printf("\nSlurmctld lock statistics (microseconds)\n");
+		for (i = 0; i < buf->lock_type_count; i++) {
+			printf("\t%-11s read  count:%-8"PRIu64" "
+			       "waited:%-8"PRIu64" wait_time:%"PRIu64"\n",
+			       _lock_type_name(i), buf->lock_rd_cnt[i],
+			       buf->lock_rd_wait_cnt[i],
+			       buf->lock_rd_wait_time[i]);
+			printf("\t%-11s write count:%-8"PRIu64" "
+			       "waited:%-8"PRIu64" wait_time:%"PRIu64"\n",
+			       _lock_type_name(i), buf->lock_wr_cnt[i],
+			       buf->lock_wr_wait_cnt[i],
+			       buf->lock_wr_wait_time[i]);
+		}
+	}
+
+	if (buf->part_sched_count) {
+		printf("\nMain schedule statistics by partition (microseconds)\n");
+		for (i = 0; i < buf->part_sched_count; i++) {
+			printf("\t%-20s tested:%-8u test_time:%-12"PRIu64" "
+			       "started:%-8u ended:%u\n",
+			       buf->part_sched_name[i],
+			       buf->part_sched_test_cnt[i],
+			       buf->part_sched_test_time[i],
+			       buf->part_sched_start_cnt[i],
+			       buf->part_sched_fail_cnt[i]);
+		}
+	}
+
 	printf("\nRemote Procedure Call statistics by message type\n");
 	for (i = 0; i < buf->rpc_type_size; i++) {
 		printf("\t%-40s(%5u) count:%-6u "
@@ -291,29 +291,31 @@ static List _query_server(bool clear_old)
 	}
 	old_part_ptr = new_part_ptr;
 
-	if (old_node_ptr) {
+	if (!params.node_name_single) {
+		/*
+		 * Only transfer the node records changed since the last
+		 * iteration. Setting NODE_STATE_MIXED below gives the same
+		 * result when repeated on an unchanged record.
+		 */
+		if (old_node_ptr && clear_old)
+			old_node_ptr->last_update = 0;
+		error_code = slurm_load_node_delta(&old_node_ptr, show_flags);
+		new_node_ptr = old_node_ptr;
+	} else if (old_node_ptr) {
 		if (clear_old)
 			old_node_ptr->last_update = 0;
-		if (params.node_name_single) {
-			error_code = slurm_load_node_single(&new_node_ptr,
-							    params.nodes,
-							    show_flags);
-		} else {
-			error_code = slurm_load_node(old_node_ptr->last_update,
-						     &new_node_ptr, show_flags);
-		}
+		error_code = slurm_load_node_single(&new_node_ptr,
+						    params.nodes,
+						    show_flags);
 		if (error_code == SLURM_SUCCESS)
 			slurm_free_node_info_msg(old_node_ptr);
 		else if (slurm_get_errno() == SLURM_NO_CHANGE_IN_DATA) {
 			error_code = SLURM_SUCCESS;
 			new_node_ptr = old_node_ptr;
 		}
-	} else if (params.node_name_single) {
+	} else {
 		error_code = slurm_load_node_single(&new_node_ptr, params.nodes,
 						    show_flags);
-	} else {
-		error_code = slurm_load_node((time_t) NULL, &new_node_ptr,
-					     show_flags);
 	}
 	if (error_code) {
 		slurm_perror("slurm_load_node");
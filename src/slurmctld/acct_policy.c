@@ -934,11 +934,40 @@ static void _qos_alter_job(struct job_record *job_ptr,
 	}
 }
 
+/*
+ * _limited_tres_range - narrow the TRES positions to check against the limits
+ * of an association or QOS to those with a limit set on it
+ *
+ * IN/OUT - limited_tres - TRES with a limit set (see assoc_mgr.c), set to NULL
+ *                         if not built for the current TRES count
+ * OUT - first - first position to check
+ * OUT - last - last position to check, less than first if no limit is set
+ */
+static void _limited_tres_range(bitstr_t **limited_tres, int *first, int *last)
+{
+	*first = 0;
+	*last = g_tres_count - 1;
+
+	if (!*limited_tres)
+		return;
+	if (bit_size(*limited_tres) != g_tres_count) {
+		*limited_tres = NULL;
+		return;
+	}
+
+	if ((*first = bit_ffs(*limited_tres)) == -1) {
+		*first = 0;
+		*last = -1;
+	} else
+		*last = bit_fls(*limited_tres);
+}
+
 /*
  * _validate_tres_limits_for_assoc - validate the tres requested against limits
  * of an association as well as qos skipping any limit an admin set
  *
  * OUT - tres_pos - if false is returned position in array of failed limit
+ * IN - limited_tres - TRES with a limit set on the association, NULL for all
  * IN - job_tres_array - count of various TRES requested by the job
  * IN - divisor - divide the job_tres_array TRES by this variable, 0 if none
  * IN - assoc_tres_array - TRES limits from an association (Grp, Max, Min)
@@ -954,6 +983,7 @@ static void _qos_alter_job(struct job_record *job_ptr,
  */
 static bool _validate_tres_limits_for_assoc(
 	int *tres_pos,
+	bitstr_t *limited_tres,
 	uint64_t *job_tres_array,
 	uint64_t divisor,
 	uint64_t *assoc_tres_array,
@@ -962,13 +992,16 @@ static bool _validate_tres_limits_for_assoc(
 	bool strict_checking,
 	bool update_call, bool max_limit)
 {
-	int i;
+	int i, first, last;
 	uint64_t job_tres;
 
 	if (!strict_checking)
 		return true;
 
-	for (i = 0; i < g_tres_count; i++) {
+	_limited_tres_range(&limited_tres, &first, &last);
+	for (i = first; i <= last; i++) {
+		if (limited_tres && !bit_test(limited_tres, i))
+			continue;
 		(*tres_pos) = i;
 
 		if ((admin_set_limit_tres_array[i] == ADMIN_SET_LIMIT)
@@ -998,6 +1031,7 @@ static bool _validate_tres_limits_for_assoc(
  * of a QOS as well as qos skipping any limit an admin set
  *
  * OUT - tres_pos - if false is returned position in array of failed limit
+ * IN - limited_tres - TRES with a limit set on the QOS, NULL for all
  * IN - job_tres_array - count of various TRES requested by the job
  * IN - divisor - divide the job_tres_array TRES by this variable, 0 if none
  * IN - grp_tres_array - Grp TRES limits from QOS
@@ -1016,6 +1050,7 @@ static bool _validate_tres_limits_for_assoc(
  */
 static bool _validate_tres_limits_for_qos(
 	int *tres_pos,
+	bitstr_t *limited_tres,
 	uint64_t *job_tres_array,
 	uint64_t divisor,
 	uint64_t *grp_tres_array,
@@ -1026,13 +1061,16 @@ static bool _validate_tres_limits_for_qos(
 	bool strict_checking, bool max_limit)
 {
 	uint64_t max_tres_limit, out_max_tres_limit;
-	int i;
+	int i, first, last;
 	uint64_t job_tres;
 
 	if (!strict_checking)
 		return true;
 
-	for (i = 0; i < g_tres_count; i++) {
+	_limited_tres_range(&limited_tres, &first, &last);
+	for (i = first; i <= last; i++) {
+		if (limited_tres && !bit_test(limited_tres, i))
+			continue;
 		(*tres_pos) = i;
 		if (grp_tres_array) {
 			max_tres_limit = MIN(grp_tres_array[i],
@@ -1204,6 +1242,8 @@ static bool _validate_tres_time_limits(
  *
  * OUT - tres_pos - if function returns other than TRES_USAGE_OKAY,
  *                  position in TRES array of failed limit
+ * IN - limited_tres - optional; TRES with a limit set on the association or
+ *                     QOS, only these positions are checked
  * IN - tres_limit_array - count of various TRES limits to check against
  * OUT - out_tres_limit_array - optional; assigned values from tres_limit_array
  *                              when out_tres_limit_set is true,
@@ -1245,6 +1285,7 @@ static bool _validate_tres_time_limits(
  */
 static acct_policy_tres_usage_t _validate_tres_usage_limits(
 	int *tres_pos,
+	bitstr_t *limited_tres,
 	uint64_t *tres_limit_array,
 	uint64_t *out_tres_limit_array,
 	uint64_t *tres_req_cnt,
@@ -1254,12 +1295,15 @@ static acct_policy_tres_usage_t _validate_tres_usage_limits(
 	bool safe_limits,
 	bool out_tres_limit_set)
 {
-	int i;
+	int i, first, last;
 	uint64_t usage = 0;
 
 	xassert(tres_limit_array);
 
-	for (i = 0; i < g_tres_count; i++) {
+	_limited_tres_range(&limited_tres, &first, &last);
+	for (i = first; i <= last; i++) {
+		if (limited_tres && !bit_test(limited_tres, i))
+			continue;
 		(*tres_pos) = i;
 
 		if ((admin_limit_set &&
@@ -1297,6 +1341,7 @@ static acct_policy_tres_usage_t _validate_tres_usage_limits(
  * against limits of an qos skipping any limit an admin set
  *
  * OUT - tres_pos - if false is returned position in array of failed limit
+ * IN - limited_tres - TRES with a limit set on the QOS, NULL for all
  * IN - tres_limit_array - TRES limits from an association
  * IN/OUT - out_tres_limit_array - TRES limits QOS has imposed already, if a new
  *                                 limit is found the limit is filled in.
@@ -1311,6 +1356,7 @@ static acct_policy_tres_usage_t _validate_tres_usage_limits(
  */
 static acct_policy_tres_usage_t _validate_tres_usage_limits_for_qos(
 	int *tres_pos,
+	bitstr_t *limited_tres,
 	uint64_t *tres_limit_array,
 	uint64_t *out_tres_limit_array,
 	uint64_t *tres_req_cnt,
@@ -1320,6 +1366,7 @@ static acct_policy_tres_usage_t _validate_tres_usage_limits_for_qos(
 	bool safe_limits)
 {
 	return _validate_tres_usage_limits(tres_pos,
+					   limited_tres,
 					   tres_limit_array,
 					   out_tres_limit_array,
 					   tres_req_cnt,
@@ -1336,6 +1383,7 @@ static acct_policy_tres_usage_t _validate_tres_usage_limits_for_qos(
  * an admin set
  *
  * OUT - tres_pos - if false is returned position in array of failed limit
+ * IN - limited_tres - TRES with a limit set on the association, NULL for all
  * IN - tres_limit_array - TRES limits from an association
  * IN - qos_tres_limit_array - TRES limits QOS has imposed already
  * IN - tres_req_cnt - TRES requested from the job
@@ -1349,6 +1397,7 @@ static acct_policy_tres_usage_t _validate_tres_usage_limits_for_qos(
  */
 static acct_policy_tres_usage_t _validate_tres_usage_limits_for_assoc(
 	int *tres_pos,
+	bitstr_t *limited_tres,
 	uint64_t *tres_limit_array,
 	uint64_t *qos_tres_limit_array,
 	uint64_t *tres_req_cnt,
@@ -1358,6 +1407,7 @@ static acct_policy_tres_usage_t _validate_tres_usage_limits_for_assoc(
 	bool safe_limits)
 {
 	return _validate_tres_usage_limits(tres_pos,
+					   limited_tres,
 					   tres_limit_array,
 					   qos_tres_limit_array,
 					   tres_req_cnt,
@@ -1387,6 +1437,7 @@ static int _qos_policy_validate(job_desc_msg_t *job_desc,
 		return rc;
 
 	if (!_validate_tres_limits_for_qos(&tres_pos,
+					   qos_ptr->usage->limited_tres,
 					   job_desc->tres_req_cnt, 0,
 					   NULL,
 					   qos_ptr->max_tres_pa_ctld,
@@ -1415,6 +1466,7 @@ static int _qos_policy_validate(job_desc_msg_t *job_desc,
 	}
 
 	if (!_validate_tres_limits_for_qos(&tres_pos,
+					   qos_ptr->usage->limited_tres,
 					   job_desc->tres_req_cnt, 0,
 					   qos_ptr->grp_tres_ctld,
 					   qos_ptr->max_tres_pu_ctld,
@@ -1621,6 +1673,7 @@ static int _qos_policy_validate(job_desc_msg_t *job_desc,
 	}
 
 	if (!_validate_tres_limits_for_qos(&tres_pos,
+					   qos_ptr->usage->limited_tres,
 					   job_desc->tres_req_cnt, 0,
 					   NULL,
 					   qos_ptr->max_tres_pj_ctld,
@@ -1646,6 +1699,7 @@ static int _qos_policy_validate(job_desc_msg_t *job_desc,
 	}
 
 	if (!_validate_tres_limits_for_qos(&tres_pos,
+					   qos_ptr->usage->limited_tres,
 					   job_desc->tres_req_cnt,
 					   job_desc->tres_req_cnt[
 						   TRES_ARRAY_NODE],
@@ -1725,6 +1779,7 @@ static int _qos_policy_validate(job_desc_msg_t *job_desc,
 	}
 
 	if (!_validate_tres_limits_for_qos(&tres_pos,
+					   qos_ptr->usage->limited_tres,
 					   job_desc->tres_req_cnt, 0,
 					   NULL,
 					   qos_ptr->min_tres_pj_ctld,
@@ -1965,7 +2020,8 @@ static int _qos_job_runnable_post_select(struct job_record *job_ptr,
 					    job_ptr->user_id);
 
 	tres_usage = _validate_tres_usage_limits_for_qos(
-		&tres_pos, qos_ptr->grp_tres_mins_ctld,
+		&tres_pos, qos_ptr->usage->limited_tres,
+		qos_ptr->grp_tres_mins_ctld,
 		qos_out_ptr->grp_tres_mins_ctld, job_tres_time_limit,
 		tres_run_mins, tres_usage_mins, job_ptr->limit_set.tres,
 		safe_limits);
@@ -2029,6 +2085,7 @@ static int _qos_job_runnable_post_select(struct job_record *job_ptr,
 	 */
 	tres_usage = _validate_tres_usage_limits_for_qos(
 		&tres_pos,
+		qos_ptr->usage->limited_tres,
 		qos_ptr->grp_tres_ctld,	qos_out_ptr->grp_tres_ctld,
 		tres_req_cnt, qos_ptr->usage->grp_used_tres,
 		NULL, job_ptr->limit_set.tres, 1);
@@ -2069,6 +2126,7 @@ static int _qos_job_runnable_post_select(struct job_record *job_ptr,
 
 	tres_usage = _validate_tres_usage_limits_for_qos(
 		&tres_pos,
+		qos_ptr->usage->limited_tres,
 		qos_ptr->grp_tres_run_mins_ctld,
 		qos_out_ptr->grp_tres_run_mins_ctld,
 		job_tres_time_limit, tres_run_mins, NULL, NULL, 1);
@@ -2111,6 +2169,7 @@ static int _qos_job_runnable_post_select(struct job_record *job_ptr,
 	/* we don't need to check grp_wall here */
 
 	if (!_validate_tres_limits_for_qos(&tres_pos,
+					   qos_ptr->usage->limited_tres,
 					   job_tres_time_limit, 0,
 					   NULL,
 					   qos_ptr->max_tres_mins_pj_ctld,
@@ -2131,6 +2190,7 @@ static int _qos_job_runnable_post_select(struct job_record *job_ptr,
 	}
 
 	if (!_validate_tres_limits_for_qos(&tres_pos,
+					   qos_ptr->usage->limited_tres,
 					   tres_req_cnt, 0,
 					   NULL,
 					   qos_ptr->max_tres_pj_ctld,
@@ -2151,6 +2211,7 @@ static int _qos_job_runnable_post_select(struct job_record *job_ptr,
 	}
 
 	if (!_validate_tres_limits_for_qos(&tres_pos,
+					   qos_ptr->usage->limited_tres,
 					   tres_req_cnt,
 					   tres_req_cnt[TRES_ARRAY_NODE],
 					   NULL,
@@ -2176,6 +2237,7 @@ static int _qos_job_runnable_post_select(struct job_record *job_ptr,
 	}
 
 	if (!_validate_tres_limits_for_qos(&tres_pos,
+					   qos_ptr->usage->limited_tres,
 					   tres_req_cnt, 0,
 					   NULL,
 					   qos_ptr->min_tres_pj_ctld,
@@ -2197,6 +2259,7 @@ static int _qos_job_runnable_post_select(struct job_record *job_ptr,
 
 	tres_usage = _validate_tres_usage_limits_for_qos(
 		&tres_pos,
+		qos_ptr->usage->limited_tres,
 		qos_ptr->max_tres_pa_ctld, qos_out_ptr->max_tres_pa_ctld,
 		tres_req_cnt, used_limits_a->tres,
 		NULL, job_ptr->limit_set.tres, 1);
@@ -2243,6 +2306,7 @@ static int _qos_job_runnable_post_select(struct job_record *job_ptr,
 
 	tres_usage = _validate_tres_usage_limits_for_qos(
 		&tres_pos,
+		qos_ptr->usage->limited_tres,
 		qos_ptr->max_tres_pu_ctld, qos_out_ptr->max_tres_pu_ctld,
 		tres_req_cnt, used_limits->tres,
 		NULL, job_ptr->limit_set.tres, 1);
@@ -2330,12 +2394,13 @@ static int _qos_job_time_out(struct job_record *job_ptr,
 	wall_mins = qos_ptr->usage->grp_used_wall / 60;
 
 	tres_usage = _validate_tres_usage_limits_for_qos(
-		&tres_pos, qos_ptr->grp_tres_mins_ctld,
+		&tres_pos, qos_ptr->usage->limited_tres,
+		qos_ptr->grp_tres_mins_ctld,
 		qos_out_ptr->grp_tres_mins_ctld, NULL,
 		NULL, tres_usage_mins, NULL, 0);
 	switch (tres_usage) {
 	case TRES_USAGE_CUR_EXCEEDS_LIMIT:
-		last_job_update = now;
+		set_job_last_update(job_ptr, now);
 		info("%pJ timed out, the job is at or exceeds QOS %s's group max tres(%s) minutes of %"PRIu64" with %"PRIu64"",
 		     job_ptr, qos_ptr->name,
 		     assoc_mgr_tres_name_array[tres_pos],
@@ -2360,7 +2425,7 @@ static int _qos_job_time_out(struct job_record *job_ptr,
 		qos_out_ptr->grp_wall = qos_ptr->grp_wall;
 
 		if (wall_mins >= qos_ptr->grp_wall) {
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			info("%pJ timed out, the job is at or exceeds QOS %s's group wall limit of %u with %u",
 			     job_ptr, qos_ptr->name,
 			     qos_ptr->grp_wall, wall_mins);
@@ -2371,7 +2436,8 @@ static int _qos_job_time_out(struct job_record *job_ptr,
 	}
 
 	tres_usage = _validate_tres_usage_limits_for_qos(
-		&tres_pos, qos_ptr->max_tres_mins_pj_ctld,
+		&tres_pos, qos_ptr->usage->limited_tres,
+		qos_ptr->max_tres_mins_pj_ctld,
 		qos_out_ptr->max_tres_mins_pj_ctld, job_tres_usage_mins,
 		NULL, NULL, NULL, 1);
 	switch (tres_usage) {
@@ -2379,7 +2445,7 @@ static int _qos_job_time_out(struct job_record *job_ptr,
 		/* not possible curr_usage is NULL */
 		break;
 	case TRES_USAGE_REQ_EXCEEDS_LIMIT:
-		last_job_update = now;
+		set_job_last_update(job_ptr, now);
 		info("%pJ timed out, the job is at or exceeds QOS %s's max tres(%s) minutes of %"PRIu64" with %"PRIu64,
 		     job_ptr, qos_ptr->name,
 		     assoc_mgr_tres_name_array[tres_pos],
@@ -2739,7 +2805,8 @@ static bool _acct_policy_validate(job_desc_msg_t *job_desc,
 		int tres_pos = 0;
 
 		if (!_validate_tres_limits_for_assoc(
-			    &tres_pos, job_desc->tres_req_cnt, 0,
+			    &tres_pos, assoc_ptr->usage->limited_tres,
+			    job_desc->tres_req_cnt, 0,
 			    assoc_ptr->grp_tres_ctld,
 			    qos_rec.grp_tres_ctld,
 			    acct_policy_limit_set->tres,
@@ -2878,7 +2945,8 @@ static bool _acct_policy_validate(job_desc_msg_t *job_desc,
 
 		tres_pos = 0;
 		if (!_validate_tres_limits_for_assoc(
-			    &tres_pos, job_desc->tres_req_cnt, 0,
+			    &tres_pos, assoc_ptr->usage->limited_tres,
+			    job_desc->tres_req_cnt, 0,
 			    assoc_ptr->max_tres_ctld,
 			    qos_rec.max_tres_pj_ctld,
 			    acct_policy_limit_set->tres,
@@ -2902,7 +2970,8 @@ static bool _acct_policy_validate(job_desc_msg_t *job_desc,
 
 		tres_pos = 0;
 		if (!_validate_tres_limits_for_assoc(
-			    &tres_pos, job_desc->tres_req_cnt,
+			    &tres_pos, assoc_ptr->usage->limited_tres,
+			    job_desc->tres_req_cnt,
 			    job_desc->tres_req_cnt[TRES_ARRAY_NODE],
 			    assoc_ptr->max_tres_pn_ctld,
 			    qos_rec.max_tres_pn_ctld,
@@ -3412,7 +3481,8 @@ extern bool acct_policy_job_runnable_post_select(
 	uint32_t time_limit;
 	bool rc = true;
 	bool safe_limits = false;
-	int i, tres_pos = 0;
+	int i, tres_pos = 0, first, last;
+	bitstr_t *limited_tres;
 	acct_policy_tres_usage_t tres_usage;
 	int parent = 0; /* flag to tell us if we are looking at the
 			 * parent or not
@@ -3494,7 +3564,10 @@ extern bool acct_policy_job_runnable_post_select(
 
 	assoc_ptr = job_ptr->assoc_ptr;
 	while (assoc_ptr) {
-		for (i=0; i<slurmctld_tres_cnt; i++) {
+		/* Usage is only looked at where the association has a limit */
+		limited_tres = assoc_ptr->usage->limited_tres;
+		_limited_tres_range(&limited_tres, &first, &last);
+		for (i = first; i <= last; i++) {
 			tres_usage_mins[i] =
 				(uint64_t)(assoc_ptr->usage->usage_tres_raw[i]
 					   / 60);
@@ -3512,7 +3585,8 @@ extern bool acct_policy_job_runnable_post_select(
 		 * is no QOS with GrpCPUMins set) we may hold the job
 		 */
 		tres_usage = _validate_tres_usage_limits_for_assoc(
-			&tres_pos, assoc_ptr->grp_tres_mins_ctld,
+			&tres_pos, assoc_ptr->usage->limited_tres,
+			assoc_ptr->grp_tres_mins_ctld,
 			qos_rec.grp_tres_mins_ctld,
 			job_tres_time_limit, tres_run_mins,
 			tres_usage_mins, job_ptr->limit_set.tres,
@@ -3576,6 +3650,7 @@ extern bool acct_policy_job_runnable_post_select(
 
 		tres_usage = _validate_tres_usage_limits_for_assoc(
 			&tres_pos,
+			assoc_ptr->usage->limited_tres,
 			assoc_ptr->grp_tres_ctld, qos_rec.grp_tres_ctld,
 			tres_req_cnt, assoc_ptr->usage->grp_used_tres,
 			NULL, job_ptr->limit_set.tres, 1);
@@ -3618,6 +3693,7 @@ extern bool acct_policy_job_runnable_post_select(
 
 		tres_usage = _validate_tres_usage_limits_for_assoc(
 			&tres_pos,
+			assoc_ptr->usage->limited_tres,
 			assoc_ptr->grp_tres_run_mins_ctld,
 			qos_rec.grp_tres_run_mins_ctld,
 			job_tres_time_limit, tres_run_mins, NULL, NULL, 1);
@@ -3672,7 +3748,8 @@ extern bool acct_policy_job_runnable_post_select(
 		}
 
 		if (!_validate_tres_limits_for_assoc(
-			    &tres_pos, job_tres_time_limit, 0,
+			    &tres_pos, assoc_ptr->usage->limited_tres,
+			    job_tres_time_limit, 0,
 			    assoc_ptr->max_tres_mins_ctld,
 			    qos_rec.max_tres_mins_pj_ctld,
 			    job_ptr->limit_set.tres,
@@ -3691,7 +3768,8 @@ extern bool acct_policy_job_runnable_post_select(
 		}
 
 		if (!_validate_tres_limits_for_assoc(
-			    &tres_pos, tres_req_cnt, 0,
+			    &tres_pos, assoc_ptr->usage->limited_tres,
+			    tres_req_cnt, 0,
 			    assoc_ptr->max_tres_ctld,
 			    qos_rec.max_tres_pj_ctld,
 			    job_ptr->limit_set.tres,
@@ -3710,7 +3788,8 @@ extern bool acct_policy_job_runnable_post_select(
 		}
 
 		if (!_validate_tres_limits_for_assoc(
-			    &tres_pos, tres_req_cnt,
+			    &tres_pos, assoc_ptr->usage->limited_tres,
+			    tres_req_cnt,
 			    tres_req_cnt[TRES_ARRAY_NODE],
 			    assoc_ptr->max_tres_pn_ctld,
 			    qos_rec.max_tres_pn_ctld,
@@ -3931,7 +4010,7 @@ extern int acct_policy_update_pending_job(struct job_record *job_ptr)
 	}
 
 	if (update_accounting) {
-		last_job_update = time(NULL);
+		set_job_last_update(job_ptr, time(NULL));
 		debug("limits changed for %pJ: updating accounting", job_ptr);
 		/* Update job record in accounting to reflect changes */
 		jobacct_storage_job_start_direct(acct_db_conn, job_ptr);
@@ -4018,12 +4097,13 @@ extern bool acct_policy_job_time_out(struct job_record *job_ptr)
 		wall_mins = assoc->usage->grp_used_wall / 60;
 
 		tres_usage = _validate_tres_usage_limits_for_assoc(
-			&tres_pos, assoc->grp_tres_mins_ctld,
+			&tres_pos, assoc->usage->limited_tres,
+			assoc->grp_tres_mins_ctld,
 			qos_rec.grp_tres_mins_ctld, NULL,
 			NULL, tres_usage_mins, NULL, 0);
 		switch (tres_usage) {
 		case TRES_USAGE_CUR_EXCEEDS_LIMIT:
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			info("%pJ timed out, the job is at or exceeds assoc %u(%s/%s/%s) group max tres(%s) minutes of %"PRIu64" with %"PRIu64,
 			     job_ptr, assoc->id, assoc->acct,
 			     assoc->user, assoc->partition,
@@ -4053,7 +4133,8 @@ extern bool acct_policy_job_time_out(struct job_record *job_ptr)
 		}
 
 		tres_usage = _validate_tres_usage_limits_for_assoc(
-			&tres_pos, assoc->max_tres_mins_ctld,
+			&tres_pos, assoc->usage->limited_tres,
+			assoc->max_tres_mins_ctld,
 			qos_rec.max_tres_mins_pj_ctld, job_tres_usage_mins,
 			NULL, NULL, NULL, 1);
 		switch (tres_usage) {
@@ -4061,7 +4142,7 @@ extern bool acct_policy_job_time_out(struct job_record *job_ptr)
 			/* not possible curr_usage is NULL */
 			break;
 		case TRES_USAGE_REQ_EXCEEDS_LIMIT:
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			info("%pJ timed out, the job is at or exceeds assoc %u(%s/%s/%s) max tres(%s) minutes of %"PRIu64" with %"PRIu64,
 			     job_ptr, assoc->id, assoc->acct,
 			     assoc->user, assoc->partition,
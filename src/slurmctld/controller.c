@@ -209,6 +209,17 @@ static pthread_mutex_t sched_cnt_mutex = PTHREAD_MUTEX_INITIALIZER;
 static pid_t	slurmctld_pid;
 static char *	slurm_conf_filename;
 
+/*
+ * Pool of persistent threads servicing accepted RPC connections.
+ * Connections are queued by _slurmctld_rpc_mgr() and picked up by idle
+ * threads, new threads only being created when none are idle.
+ */
+static pthread_cond_t	service_cond = PTHREAD_COND_INITIALIZER;
+static int		service_idle_cnt = 0;
+static pthread_mutex_t	service_mutex = PTHREAD_MUTEX_INITIALIZER;
+static List		service_queue = NULL;
+static int		service_thread_cnt = 0;
+
 /*
  * Static list of signals to block in this process
  * *Must be zero-terminated*
@@ -238,10 +249,12 @@ static int          _init_tres(void);
 static void         _kill_old_slurmctld(void);
 static void         _parse_commandline(int argc, char **argv);
 static void *       _purge_files_thread(void *no_data);
+static void         _queue_connection(connection_arg_t *conn_arg);
 static void         _remove_assoc(slurmdb_assoc_rec_t *rec);
 static void         _remove_qos(slurmdb_qos_rec_t *rec);
 static void         _run_primary_prog(bool primary_on);
 static void *       _service_connection(void *arg);
+static void *       _service_thread(void *no_data);
 static void         _set_work_dir(void);
 static int          _shutdown_backup_controller(void);
 static void *       _slurmctld_background(void *no_data);
@@ -1098,7 +1111,8 @@ static void _sig_handler(int signal)
 }
 
 /*
- * _slurmctld_rpc_mgr - Read incoming RPCs and create pthread for each
+ * _slurmctld_rpc_mgr - Read incoming RPCs and queue each for processing by
+ *	the pool of service threads
  */
 static void *_slurmctld_rpc_mgr(void *no_data)
 {
@@ -1216,8 +1230,7 @@ static void *_slurmctld_rpc_mgr(void *no_data)
 			slurmctld_diag_stats.proc_req_raw++;
 			_service_connection(conn_arg);
 		} else {
-			slurm_thread_create_detached(NULL, _service_connection,
-						     conn_arg);
+			_queue_connection(conn_arg);
 		}
 	}
 
@@ -1225,11 +1238,67 @@ static void *_slurmctld_rpc_mgr(void *no_data)
 	for (i = 0; i < nports; i++)
 		close(fds[i].fd);
 	xfree(fds);
+
+	/* Wake idle service threads so they can exit */
+	slurm_mutex_lock(&service_mutex);
+	slurm_cond_broadcast(&service_cond);
+	slurm_mutex_unlock(&service_mutex);
+
 	server_thread_decr();
 	pthread_exit((void *) 0);
 	return NULL;
 }
 
+/*
+ * _queue_connection - hand an accepted connection to the service thread
+ *	pool, creating a new service thread if none is idle. The number of
+ *	queued and active connections is already bounded by
+ *	_wait_for_server_thread(), which also bounds the pool size.
+ * IN conn_arg - connection to service, freed by _service_connection()
+ */
+static void _queue_connection(connection_arg_t *conn_arg)
+{
+	slurm_mutex_lock(&service_mutex);
+	if (!service_queue)
+		service_queue = list_create(NULL);
+	list_enqueue(service_queue, conn_arg);
+	if ((list_count(service_queue) > service_idle_cnt) &&
+	    (service_thread_cnt < max_server_threads)) {
+		service_thread_cnt++;
+		slurm_thread_create_detached(NULL, _service_thread, NULL);
+	} else
+		slurm_cond_signal(&service_cond);
+	slurm_mutex_unlock(&service_mutex);
+}
+
+/*
+ * _service_thread - persistent thread servicing queued RPC connections
+ *	until slurmctld shutdown
+ */
+static void *_service_thread(void *no_data)
+{
+	connection_arg_t *conn_arg;
+
+	slurm_mutex_lock(&service_mutex);
+	while (1) {
+		if ((conn_arg = list_dequeue(service_queue))) {
+			slurm_mutex_unlock(&service_mutex);
+			_service_connection(conn_arg);
+			slurm_mutex_lock(&service_mutex);
+			continue;
+		}
+		if (slurmctld_config.shutdown_time)
+			break;
+		service_idle_cnt++;
+		slurm_cond_wait(&service_cond, &service_mutex);
+		service_idle_cnt--;
+	}
+	service_thread_cnt--;
+	slurm_mutex_unlock(&service_mutex);
+
+	return NULL;
+}
+
 /*
  * _service_connection - service the RPC
  * IN/OUT arg - really just the connection's file descriptor, freed
@@ -1843,6 +1912,7 @@ static void _queue_reboot_msg(void)
 
 		if ((node_ptr->next_state != NO_VAL) && (node_ptr->reason))
 			xstrcat(node_ptr->reason, " : reboot issued");
+		set_node_last_update(node_ptr, now);
 	}
 	if (reboot_agent_args != NULL) {
 		hostlist_uniq(reboot_agent_args->hostlist);
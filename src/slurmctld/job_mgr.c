@@ -106,6 +106,11 @@
 
 #define ARRAY_ID_BUF_SIZE 32
 #define DETAILS_FLAG 0xdddd
+#define JOB_INFO_CACHE_AGE 5	/* seconds a cached job info response may
+				 * be reused, expected start times of
+				 * pending jobs are packed relative to now */
+#define JOB_INFO_CACHE_CNT 8	/* packed job info responses to cache */
+#define JOB_PURGE_HIST_CNT 8192	/* purged job IDs kept for job info deltas */
 #define MAX_EXIT_VAL 255	/* Maximum value returned by WIFEXITED() */
 #define SLURM_CREATE_JOB_FLAG_NO_ALLOCATE_0 0
 #define TOP_PRIORITY 0xffff0000	/* large, but leave headroom for higher */
@@ -141,6 +146,52 @@ typedef struct {
 	uid_t     uid;
 } _foreach_pack_job_info_t;
 
+/*
+ * Header of a pack_all_jobs() response buffer, which is shared by the cache
+ * and the RPCs sending it. See free_job_info_buf().
+ */
+typedef struct {
+	int       ref_cnt;		/* protected by job_info_cache_mutex */
+} job_info_buf_t;
+
+/*
+ * A packed pack_all_jobs() response. Reused for identical requests while no
+ * job, partition or configuration change has been recorded since the
+ * second before it was built, for up to JOB_INFO_CACHE_AGE seconds.
+ */
+typedef struct {
+	time_t    build_time;		/* when response was packed */
+	char     *buffer;		/* packed response, after its
+					 * job_info_buf_t header */
+	int       buffer_size;		/* size of buffer in bytes */
+	time_t    conf_update;		/* slurmctld_conf.last_update */
+	uint32_t  filter_uid;
+	time_t    job_update;		/* last_job_update */
+	time_t    part_update;		/* last_part_update */
+	uint16_t  protocol_version;
+	uint16_t  show_flags;
+	uid_t     uid;
+} job_info_cache_t;
+
+/* Jobs to remove from job_list when replaying the job state journal */
+typedef struct {
+	uint32_t *job_ids;		/* sorted */
+	uint32_t  job_cnt;
+} job_journal_del_t;
+
+/* A job record recovered by _load_job_state() */
+typedef struct {
+	uint32_t  job_id;
+	uint32_t  load_inx;		/* order loaded, the last one counts */
+	bool      valid_assoc;		/* sync with accounting database */
+} job_load_acct_t;
+
+/* A job removed from job_list, reported in job info deltas */
+typedef struct {
+	uint32_t  job_id;
+	time_t    purge_time;
+} job_purge_rec_t;
+
 /* Global variables */
 List   job_list = NULL;		/* job_record list */
 time_t last_job_update;		/* time of last update to job records */
@@ -153,11 +204,34 @@ static uint32_t delay_boot = 0;
 static uint32_t highest_prio = 0;
 static uint32_t lowest_prio  = TOP_PRIORITY;
 static int      hash_table_size = 0;
+static int      job_hash_cnt = 0;	/* job records in job_hash */
 static int      job_count = 0;		/* job's in the system */
 static uint32_t job_id_sequence = 0;	/* first job_id to assign new job */
 static struct   job_record **job_hash = NULL;
 static struct   job_record **job_array_hash_j = NULL;
 static struct   job_record **job_array_hash_t = NULL;
+static job_info_cache_t job_info_cache[JOB_INFO_CACHE_CNT];
+static int      job_info_cache_next = 0;
+static pthread_mutex_t job_info_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static job_purge_rec_t job_purge_hist[JOB_PURGE_HIST_CNT];
+static time_t   job_purge_hist_lost = (time_t) 0; /* latest purge dropped
+						   * from job_purge_hist */
+static int      job_purge_hist_next = 0;
+static uint32_t job_journal_job_id = 0;	/* job_id_sequence last saved */
+static uint32_t *job_journal_purge = NULL; /* jobs purged since last save */
+static uint32_t job_journal_purge_cnt = 0;
+static uint32_t job_journal_purge_size = 0;
+static uint32_t job_journal_size = 0;	/* bytes in job_state.journal */
+static job_load_acct_t *job_load_acct = NULL; /* jobs recovered, to be
+					       * synced with the database */
+static uint32_t job_load_acct_cnt = 0;
+static uint32_t job_load_acct_size = 0;
+static uint32_t job_journal_time_offset = 0; /* offset of the journal's
+					      * last write time */
+static bool     job_journal_valid = false; /* job_state.journal follows the
+					    * job_state file we last wrote */
+static time_t   job_snapshot_time = (time_t) 0; /* job_state time stamp */
+static uint32_t job_snapshot_size = 0;	/* bytes in job_state file */
 static bool     kill_invalid_dep;
 static time_t   last_file_write_time = (time_t) 0;
 static uint32_t max_array_size = NO_VAL;
@@ -205,6 +279,11 @@ static int  _load_job_details(struct job_record *job_ptr, Buf buffer,
 			      uint16_t protocol_version);
 static int  _load_job_fed_details(job_fed_details_t **fed_details_pptr,
 				  Buf buffer, uint16_t protocol_version);
+static void _load_job_acct(void);
+static int  _load_job_journal(time_t snapshot_time, bool job_id_only);
+static int  _unpack_job_journal_header(Buf buffer, uint16_t *protocol_version,
+				       time_t *journal_time,
+				       time_t *write_time);
 static int  _load_job_state(Buf buffer,	uint16_t protocol_version);
 static bitstr_t *_make_requeue_array(char *conf_buf);
 static uint32_t _max_switch_wait(uint32_t input_wait);
@@ -221,6 +300,9 @@ static void _pack_pending_job_details(struct job_details *detail_ptr,
 				      uint16_t protocol_version);
 static bool _parse_array_tok(char *tok, bitstr_t *array_bitmap, uint32_t max);
 static void _purge_missing_jobs(int node_inx, time_t now);
+static void _record_job_journal_purge(uint32_t job_id);
+static void _record_job_load_acct(uint32_t job_id, bool valid_assoc);
+static void _record_job_purge(uint32_t job_id);
 static int  _read_data_array_from_file(int fd, char *file_name, char ***data,
 				       uint32_t * size,
 				       struct job_record *job_ptr);
@@ -228,6 +310,9 @@ static char *_read_job_ckpt_file(char *ckpt_file, int *size_ptr);
 static void _remove_defunct_batch_dirs(List batch_dirs);
 static void _remove_job_hash(struct job_record *job_ptr,
 			     job_hash_type_t type);
+static void _resize_job_hash(int new_size);
+static int  _write_job_journal_time(char *file_name, time_t write_time);
+static int  _write_job_state_file(char *file_name, Buf buffer, int flags);
 static int  _reset_detail_bitmaps(struct job_record *job_ptr);
 static void _reset_step_bitmaps(struct job_record *job_ptr);
 static void _resp_array_add(resp_array_struct_t **resp,
@@ -468,12 +553,12 @@ static struct job_record *_create_job_record(uint32_t num_jobs)
 	}
 
 	job_count += num_jobs;
-	last_job_update = time(NULL);
 
 	job_ptr    = (struct job_record *) xmalloc(sizeof(struct job_record));
 	detail_ptr = (struct job_details *)xmalloc(sizeof(struct job_details));
 
 	job_ptr->magic = JOB_MAGIC;
+	set_job_last_update(job_ptr, time(NULL));
 	job_ptr->array_task_id = NO_VAL;
 	job_ptr->details = detail_ptr;
 	job_ptr->prio_factors = xmalloc(sizeof(priority_factors_object_t));
@@ -665,16 +750,20 @@ static slurmdb_qos_rec_t *_determine_and_validate_qos(
 
 /*
  * dump_all_job_state - save the state of all jobs to file for checkpoint
- *	Changes here should be reflected in load_last_job_id() and
- *	load_all_job_state().
+ *	Only the records of jobs changed since the previous save are appended
+ *	to the job_state.journal file. A full job_state snapshot is written
+ *	(and the journal restarted) on the first save and whenever the journal
+ *	has grown larger than the snapshot.
+ *	Changes here should be reflected in load_last_job_id(),
+ *	load_all_job_state() and _load_job_journal().
  * RET 0 or error code
  */
 int dump_all_job_state(void)
 {
 	/* Save high-water mark to avoid buffer growth with copies */
 	static int high_buffer_size = (1024 * 1024);
-	int error_code = SLURM_SUCCESS, log_fd;
-	char *old_file, *new_file, *reg_file;
+	int error_code = SLURM_SUCCESS;
+	char *old_file, *new_file, *reg_file, *journal_file;
 	struct stat stat_buf;
 	/* Locks: Read config and job */
 	slurmctld_lock_t job_read_lock =
@@ -684,6 +773,10 @@ int dump_all_job_state(void)
 	Buf buffer = init_buf(high_buffer_size);
 	time_t now = time(NULL);
 	time_t last_state_file_time;
+	bool snapshot;
+	uint32_t len_offset = 0, cnt_offset = 0, rec_offset, job_offset;
+	uint32_t purge_cnt, update_cnt = 0, end_offset, job_len;
+	char *job_data;
 	DEF_TIMERS;
 
 	START_TIMER;
@@ -706,29 +799,95 @@ int dump_all_job_state(void)
 		}
 	}
 
-	/* write header: version, time */
-	packstr(JOB_STATE_VERSION, buffer);
-	pack16(SLURM_PROTOCOL_VERSION, buffer);
-	pack_time(now, buffer);
+	lock_slurmctld(job_read_lock);
+	snapshot = !job_journal_valid ||
+		   (job_journal_size > job_snapshot_size);
+	if (snapshot) {
+		/*
+		 * The journal header identifies its snapshot by time stamp,
+		 * so never write two snapshots with the same time stamp.
+		 */
+		now = MAX(now, job_snapshot_time + 1);
 
-	/*
-	 * write header: job id
-	 * This is needed so that the job id remains persistent even after
-	 * slurmctld is restarted.
-	 */
-	pack32( job_id_sequence, buffer);
+		/* write header: version, time */
+		packstr(JOB_STATE_VERSION, buffer);
+		pack16(SLURM_PROTOCOL_VERSION, buffer);
+		pack_time(now, buffer);
+
+		/*
+		 * write header: job id
+		 * This is needed so that the job id remains persistent even
+		 * after slurmctld is restarted.
+		 */
+		pack32(job_id_sequence, buffer);
 
-	debug3("Writing job id %u to header record of job_state file",
-	       job_id_sequence);
+		debug3("Writing job id %u to header record of job_state file",
+		       job_id_sequence);
+	} else {
+		/*
+		 * write journal record: length, time, job id, purged jobs,
+		 * then the state of every job changed since the last save
+		 */
+		len_offset = get_buf_offset(buffer);
+		pack32(0, buffer);
+		pack_time(now, buffer);
+		pack32(job_id_sequence, buffer);
+		pack32_array(job_journal_purge, job_journal_purge_cnt, buffer);
+		cnt_offset = get_buf_offset(buffer);
+		pack32(0, buffer);
+	}
+	purge_cnt = job_journal_purge_cnt;
+	job_journal_purge_cnt = 0;
 
 	/* write individual job records */
-	lock_slurmctld(job_read_lock);
 	job_iterator = list_iterator_create(job_list);
 	while ((job_ptr = (struct job_record *) list_next(job_iterator))) {
+		rec_offset = get_buf_offset(buffer);
+		if (!snapshot) {
+			pack32(job_ptr->job_id, buffer);
+			pack32(0, buffer);	/* record length, set below */
+		}
+		job_offset = get_buf_offset(buffer);
 		_dump_job_state(job_ptr, buffer);
+		job_len = get_buf_offset(buffer) - job_offset;
+		job_data = get_buf_data(buffer) + job_offset;
+		if (!snapshot && (job_len == job_ptr->state_rec_len) &&
+		    !memcmp(job_data, job_ptr->state_rec, job_len)) {
+			/* Unchanged since last saved, drop the record */
+			set_buf_offset(buffer, rec_offset);
+			continue;
+		}
+		if (job_len > job_ptr->state_rec_len)
+			xrealloc_nz(job_ptr->state_rec, job_len);
+		memcpy(job_ptr->state_rec, job_data, job_len);
+		job_ptr->state_rec_len = job_len;
+		update_cnt++;
+		if (!snapshot) {
+			end_offset = get_buf_offset(buffer);
+			set_buf_offset(buffer, job_offset - sizeof(uint32_t));
+			pack32(end_offset - job_offset, buffer);
+			set_buf_offset(buffer, end_offset);
+		}
 	}
 	list_iterator_destroy(job_iterator);
 
+	if (!snapshot && !update_cnt && !purge_cnt &&
+	    (job_journal_job_id == job_id_sequence)) {
+		/* Nothing changed since the last save */
+		unlock_slurmctld(job_read_lock);
+		free_buf(buffer);
+		END_TIMER2("dump_all_job_state");
+		return error_code;
+	}
+	if (!snapshot) {
+		end_offset = get_buf_offset(buffer);
+		set_buf_offset(buffer, len_offset);
+		pack32(end_offset - len_offset - sizeof(uint32_t), buffer);
+		set_buf_offset(buffer, cnt_offset);
+		pack32(update_cnt, buffer);
+		set_buf_offset(buffer, end_offset);
+	}
+	job_journal_job_id = job_id_sequence;
 
 	/* write the buffer to file */
 	old_file = xstrdup(slurmctld_conf.state_save_location);
@@ -737,6 +896,8 @@ int dump_all_job_state(void)
 	xstrcat(reg_file, "/job_state");
 	new_file = xstrdup(slurmctld_conf.state_save_location);
 	xstrcat(new_file, "/job_state.new");
+	journal_file = xstrdup(slurmctld_conf.state_save_location);
+	xstrcat(journal_file, "/job_state.journal");
 	unlock_slurmctld(job_read_lock);
 
 	if (stat(reg_file, &stat_buf) == 0) {
@@ -754,34 +915,28 @@ int dump_all_job_state(void)
 		last_mtime = time(NULL);
 	}
 
+	high_buffer_size = MAX(get_buf_offset(buffer), high_buffer_size);
 	lock_state_files();
-	log_fd = open(new_file, O_CREAT|O_WRONLY|O_TRUNC|O_CLOEXEC, 0600);
-	if (log_fd < 0) {
-		error("Can't save state, create file %s error %m",
-		      new_file);
-		error_code = errno;
-	} else {
-		int pos = 0, nwrite, amount, rc;
-		char *data;
-
-		nwrite = get_buf_offset(buffer);
-		data = (char *)get_buf_data(buffer);
-		high_buffer_size = MAX(nwrite, high_buffer_size);
-		while (nwrite > 0) {
-			amount = write(log_fd, &data[pos], nwrite);
-			if ((amount < 0) && (errno != EINTR)) {
-				error("Error writing file %s, %m", new_file);
-				error_code = errno;
-				break;
-			}
-			nwrite -= amount;
-			pos    += amount;
+	if (!snapshot) {
+		error_code = _write_job_state_file(journal_file, buffer,
+						   O_APPEND);
+		if (!error_code) {
+			/* for the split brain test on the next save */
+			error_code = _write_job_journal_time(journal_file,
+							     now);
 		}
-
-		rc = fsync_and_close(log_fd, "job");
-		if (rc && !error_code)
-			error_code = rc;
+		if (error_code) {
+			/* Journal may now be damaged, start over */
+			job_journal_valid = false;
+		} else {
+			job_journal_size += get_buf_offset(buffer);
+			last_file_write_time = now;
+		}
+		goto fini;
 	}
+
+	job_journal_valid = false;
+	error_code = _write_job_state_file(new_file, buffer, O_TRUNC);
 	if (error_code)
 		(void) unlink(new_file);
 	else {			/* file shuffle */
@@ -795,10 +950,31 @@ int dump_all_job_state(void)
 			       new_file, reg_file);
 		(void) unlink(new_file);
 		last_file_write_time = now;
+		job_snapshot_time = now;
+		job_snapshot_size = get_buf_offset(buffer);
+
+		/*
+		 * start a new journal following this snapshot, the header
+		 * ends with the time of the latest write to the journal
+		 */
+		set_buf_offset(buffer, 0);
+		packstr(JOB_STATE_VERSION, buffer);
+		pack16(SLURM_PROTOCOL_VERSION, buffer);
+		pack_time(now, buffer);
+		job_journal_time_offset = get_buf_offset(buffer);
+		pack_time(now, buffer);
+		error_code = _write_job_state_file(journal_file, buffer,
+						   O_TRUNC);
+		if (error_code == SLURM_SUCCESS) {
+			job_journal_size = get_buf_offset(buffer);
+			job_journal_valid = true;
+		}
 	}
-	xfree(old_file);
+
+fini:	xfree(old_file);
 	xfree(reg_file);
 	xfree(new_file);
+	xfree(journal_file);
 	unlock_state_files();
 
 	free_buf(buffer);
@@ -806,6 +982,81 @@ int dump_all_job_state(void)
 	return error_code;
 }
 
+/*
+ * Write the contents of a buffer to a state save file
+ * IN file_name - file to write
+ * IN buffer - data to write
+ * IN flags - O_TRUNC to replace the file or O_APPEND to add to it
+ * RET 0 or error code
+ * NOTE: call lock_state_files() before entry
+ */
+static int _write_job_state_file(char *file_name, Buf buffer, int flags)
+{
+	int error_code = SLURM_SUCCESS, log_fd;
+	int pos = 0, nwrite, amount, rc;
+	char *data;
+
+	log_fd = open(file_name, O_CREAT|O_WRONLY|O_CLOEXEC|flags, 0600);
+	if (log_fd < 0) {
+		error("Can't save state, create file %s error %m",
+		      file_name);
+		return errno;
+	}
+
+	nwrite = get_buf_offset(buffer);
+	data = (char *)get_buf_data(buffer);
+	while (nwrite > 0) {
+		amount = write(log_fd, &data[pos], nwrite);
+		if ((amount < 0) && (errno != EINTR)) {
+			error("Error writing file %s, %m", file_name);
+			error_code = errno;
+			break;
+		}
+		nwrite -= amount;
+		pos    += amount;
+	}
+
+	rc = fsync_and_close(log_fd, "job");
+	if (rc && !error_code)
+		error_code = rc;
+	return error_code;
+}
+
+/*
+ * Record the time of the latest append in the job state journal's header
+ * IN file_name - job state journal
+ * IN write_time - time stamp of the record appended
+ * RET 0 or error code
+ * NOTE: call lock_state_files() before entry
+ */
+static int _write_job_journal_time(char *file_name, time_t write_time)
+{
+	int error_code = SLURM_SUCCESS, log_fd, rc;
+	Buf buffer = init_buf(sizeof(uint64_t));
+	ssize_t size;
+
+	pack_time(write_time, buffer);
+	log_fd = open(file_name, O_WRONLY|O_CLOEXEC);
+	if (log_fd < 0) {
+		error("Can't save state, open file %s error %m", file_name);
+		error_code = errno;
+		goto fini;
+	}
+
+	size = pwrite(log_fd, get_buf_data(buffer), get_buf_offset(buffer),
+		      job_journal_time_offset);
+	if (size != get_buf_offset(buffer)) {
+		error("Error writing file %s, %m", file_name);
+		error_code = (size < 0) ? errno : EIO;
+	}
+
+	rc = fsync_and_close(log_fd, "job");
+	if (rc && !error_code)
+		error_code = rc;
+fini:	free_buf(buffer);
+	return error_code;
+}
+
 static int _find_resv_part(void *x, void *key)
 {
 	slurmctld_resv_t *resv_ptr = (slurmctld_resv_t *) x;
@@ -888,16 +1139,17 @@ extern void set_job_tres_alloc_str(struct job_record *job_ptr,
 extern void backup_slurmctld_restart(void)
 {
 	last_file_write_time = (time_t) 0;
+	job_journal_valid = false;
 }
 
-/* Return the time stamp in the current job state save file, 0 is returned on
- * error */
+/* Return the time stamp of the latest write to the current job state save
+ * file or the journal following it, 0 is returned on error */
 static time_t _get_last_job_state_write_time(void)
 {
 	int error_code = SLURM_SUCCESS;
-	char *state_file = NULL;
+	char *state_file = NULL, *journal_file;
 	Buf buffer;
-	time_t buf_time = (time_t) 0;
+	time_t buf_time = (time_t) 0, journal_time, write_time;
 	char *ver_str = NULL;
 	uint32_t ver_str_len;
 	uint16_t protocol_version = NO_VAL16;
@@ -915,6 +1167,19 @@ static time_t _get_last_job_state_write_time(void)
 	if (ver_str && !xstrcmp(ver_str, JOB_STATE_VERSION))
 		safe_unpack16(&protocol_version, buffer);
 	safe_unpack_time(&buf_time, buffer);
+	free_buf(buffer);
+
+	/* Saves between snapshots are only appended to the journal */
+	journal_file = xstrdup(slurmctld_conf.state_save_location);
+	xstrcat(journal_file, "/job_state.journal");
+	buffer = create_mmap_buf(journal_file);
+	xfree(journal_file);
+	if (!buffer)
+		return buf_time;
+	if (!_unpack_job_journal_header(buffer, &protocol_version,
+					&journal_time, &write_time) &&
+	    (journal_time == buf_time))
+		buf_time = MAX(buf_time, write_time);
 
 unpack_error:
 	xfree(ver_str);
@@ -940,6 +1205,9 @@ extern int load_all_job_state(void)
 	uint32_t ver_str_len;
 	uint16_t protocol_version = NO_VAL16;
 
+	/* the next save must write a full snapshot */
+	job_journal_valid = false;
+
 	/* read the file */
 	lock_state_files();
 	if (!(buffer = _open_job_state_file(&state_file))) {
@@ -988,9 +1256,15 @@ extern int load_all_job_state(void)
 			goto unpack_error;
 		job_cnt++;
 	}
+	free_buf(buffer);
+	job_snapshot_time = buf_time;
+
+	error_code = _load_job_journal(buf_time, false);
+	if (error_code == SLURM_SUCCESS)
+		job_cnt = list_count(job_list);
+	_load_job_acct();
 	debug3("Set job_id_sequence to %u", job_id_sequence);
 
-	free_buf(buffer);
 	info("Recovered information about %d jobs", job_cnt);
 	return error_code;
 
@@ -1000,6 +1274,7 @@ unpack_error:
 	error("Incomplete job state save file");
 	info("Recovered information about %d jobs", job_cnt);
 	free_buf(buffer);
+	_load_job_acct();
 	return SLURM_ERROR;
 }
 
@@ -1052,7 +1327,9 @@ extern int load_last_job_id( void )
 
 	xfree(ver_str);
 	free_buf(buffer);
-	return SLURM_SUCCESS;
+
+	/* Job IDs assigned since the snapshot are in the journal */
+	return _load_job_journal(buf_time, true);
 
 unpack_error:
 	if (!ignore_state_errors)
@@ -1063,6 +1340,312 @@ unpack_error:
 	return SLURM_ERROR;
 }
 
+static int _cmp_job_id(const void *x, const void *y)
+{
+	uint32_t a = *(uint32_t *) x, b = *(uint32_t *) y;
+
+	if (a < b)
+		return -1;
+	return (a > b);
+}
+
+static int _cmp_job_load_acct(const void *x, const void *y)
+{
+	job_load_acct_t *a = (job_load_acct_t *) x, *b = (job_load_acct_t *) y;
+
+	if (a->job_id != b->job_id)
+		return (a->job_id < b->job_id) ? -1 : 1;
+	if (a->load_inx != b->load_inx)
+		return (a->load_inx < b->load_inx) ? -1 : 1;
+	return 0;
+}
+
+/* Record a recovered job to be synchronized with the accounting database */
+static void _record_job_load_acct(uint32_t job_id, bool valid_assoc)
+{
+	job_load_acct_t *load_rec;
+
+	if (job_load_acct_cnt >= job_load_acct_size) {
+		job_load_acct_size = MAX(1024, job_load_acct_size * 2);
+		xrealloc(job_load_acct,
+			 sizeof(job_load_acct_t) * job_load_acct_size);
+	}
+	load_rec = &job_load_acct[job_load_acct_cnt];
+	load_rec->job_id = job_id;
+	load_rec->load_inx = job_load_acct_cnt++;
+	load_rec->valid_assoc = valid_assoc;
+}
+
+/*
+ * _load_job_acct - make sure that the accounting database has the start, and
+ *	if finished the completion, of every job recovered by
+ *	_load_job_state(). Each job is handled once, according to the last of
+ *	its records loaded from the job_state snapshot and journal.
+ */
+static void _load_job_acct(void)
+{
+	struct job_record *job_ptr;
+	uint32_t i;
+	assoc_mgr_lock_t locks = { .assoc = READ_LOCK,
+				   .qos = READ_LOCK,
+				   .tres = READ_LOCK,
+				   .user = READ_LOCK };
+
+	if (!job_load_acct_cnt)
+		return;
+
+	qsort(job_load_acct, job_load_acct_cnt, sizeof(job_load_acct_t),
+	      _cmp_job_load_acct);
+	assoc_mgr_lock(&locks);
+	for (i = 0; i < job_load_acct_cnt; i++) {
+		/* only the job's last record loaded counts */
+		if (((i + 1) < job_load_acct_cnt) &&
+		    (job_load_acct[i + 1].job_id == job_load_acct[i].job_id))
+			continue;
+		if (!job_load_acct[i].valid_assoc ||
+		    !(job_ptr = find_job_record(job_load_acct[i].job_id)))
+			continue;
+
+		/* make sure we have started this job in accounting */
+		if (!job_ptr->db_index) {
+			debug("starting %pJ in accounting", job_ptr);
+			if (!with_slurmdbd)
+				jobacct_storage_g_job_start(
+					acct_db_conn, job_ptr);
+			if (slurmctld_init_db
+			    && IS_JOB_SUSPENDED(job_ptr)) {
+				jobacct_storage_g_job_suspend(acct_db_conn,
+							      job_ptr);
+			}
+		}
+		/* make sure we have this job completed in the database */
+		if (IS_JOB_FINISHED(job_ptr)) {
+			if (slurmctld_init_db &&
+			    !(job_ptr->bit_flags & TRES_STR_CALC) &&
+			    job_ptr->tres_alloc_cnt &&
+			    (job_ptr->tres_alloc_cnt[TRES_ENERGY] != NO_VAL64))
+				set_job_tres_alloc_str(job_ptr, false);
+			jobacct_storage_g_job_complete(
+				acct_db_conn, job_ptr);
+		}
+	}
+	assoc_mgr_unlock(&locks);
+
+	xfree(job_load_acct);
+	job_load_acct_cnt = 0;
+	job_load_acct_size = 0;
+}
+
+/* key is a job_journal_del_t, with a sorted array of job IDs */
+static int _list_find_job_ids(void *job_entry, void *key)
+{
+	job_journal_del_t *del = (job_journal_del_t *) key;
+	struct job_record *job_ptr = (struct job_record *) job_entry;
+
+	if (bsearch(&job_ptr->job_id, del->job_ids, del->job_cnt,
+		    sizeof(uint32_t), _cmp_job_id))
+		return 1;
+	return 0;
+}
+
+/*
+ * _valid_job_journal_rec - check that a complete job state journal record
+ *	starts at the buffer's current offset. A crash while a record was being
+ *	appended can leave a short or partly written record at the end of the
+ *	journal. The buffer's offset is left unchanged.
+ * IN buffer - job state journal contents
+ * OUT rec_end - offset just past the end of the record
+ * RET true if the record is complete
+ */
+static bool _valid_job_journal_rec(Buf buffer, uint32_t *rec_end)
+{
+	uint32_t rec_offset = get_buf_offset(buffer);
+	uint32_t rec_len, saved_job_id, purge_cnt, update_cnt, job_len, i;
+	uint32_t *purge_ids = NULL;
+	time_t rec_time;
+	bool valid = false;
+
+	safe_unpack32(&rec_len, buffer);
+	if (rec_len > remaining_buf(buffer))
+		goto unpack_error;
+	*rec_end = get_buf_offset(buffer) + rec_len;
+	safe_unpack_time(&rec_time, buffer);
+	safe_unpack32(&saved_job_id, buffer);
+	safe_unpack32_array(&purge_ids, &purge_cnt, buffer);
+	safe_unpack32(&update_cnt, buffer);
+	for (i = 0; i < update_cnt; i++) {
+		safe_unpack32(&saved_job_id, buffer);
+		safe_unpack32(&job_len, buffer);
+		if (job_len > remaining_buf(buffer))
+			goto unpack_error;
+		set_buf_offset(buffer, get_buf_offset(buffer) + job_len);
+	}
+	valid = (get_buf_offset(buffer) == *rec_end);
+
+unpack_error:
+	xfree(purge_ids);
+	set_buf_offset(buffer, rec_offset);
+	return valid;
+}
+
+/*
+ * _load_job_journal - apply the job_state.journal records written since the
+ *	job_state snapshot, removing purged jobs and replacing the records of
+ *	updated jobs. The journal is ignored unless it follows that snapshot.
+ *	A short or incomplete record, left by a failure while it was being
+ *	appended, ends the journal and is truncated from the file.
+ *	Changes here should be reflected in dump_all_job_state().
+ * IN snapshot_time - time stamp of the job_state file loaded
+ * IN job_id_only - only recover job_id_sequence, for load_last_job_id()
+ * RET 0 or error code
+ */
+static int _load_job_journal(time_t snapshot_time, bool job_id_only)
+{
+	char *journal_file = NULL;
+	uint32_t rec_end, saved_job_id, job_len;
+	uint32_t rec_offset = 0, purge_cnt, update_cnt, upd_offset, i;
+	uint16_t protocol_version = NO_VAL16;
+	time_t journal_time = 0, write_time, rec_time;
+	char time_str[32];
+	job_journal_del_t del = { NULL, 0 };
+	int rec_cnt = 0;
+	bool torn = false;
+	Buf buffer;
+
+	journal_file = xstrdup(slurmctld_conf.state_save_location);
+	xstrcat(journal_file, "/job_state.journal");
+	lock_state_files();
+	buffer = create_mmap_buf(journal_file);
+	unlock_state_files();
+	if (!buffer) {
+		debug("No job state journal (%s) to recover", journal_file);
+		xfree(journal_file);
+		return SLURM_SUCCESS;
+	}
+
+	if (_unpack_job_journal_header(buffer, &protocol_version,
+				       &journal_time, &write_time) ||
+	    (journal_time != snapshot_time)) {
+		info("Job state journal (%s) is incomplete or does not follow the job state file, ignored",
+		     journal_file);
+		goto fini;
+	}
+
+	while (remaining_buf(buffer) > 0) {
+		rec_offset = get_buf_offset(buffer);
+		if (!_valid_job_journal_rec(buffer, &rec_end)) {
+			error("Incomplete job state journal record at offset %u, ignored",
+			      rec_offset);
+			torn = true;
+			break;
+		}
+		set_buf_offset(buffer, rec_offset + sizeof(uint32_t));
+		safe_unpack_time(&rec_time, buffer);
+		safe_unpack32(&saved_job_id, buffer);
+		slurm_make_time_str(&rec_time, time_str, sizeof(time_str));
+		debug3("Job state journal record from %s, job id %u",
+		       time_str, saved_job_id);
+		if (job_id_only)
+			job_id_sequence = saved_job_id;
+		else if (saved_job_id <= slurmctld_conf.max_job_id)
+			job_id_sequence = MAX(saved_job_id, job_id_sequence);
+		rec_cnt++;
+		if (job_id_only) {
+			set_buf_offset(buffer, rec_end);
+			continue;
+		}
+
+		/* Remove purged jobs and the old records of updated jobs */
+		safe_unpack32_array(&del.job_ids, &purge_cnt, buffer);
+		safe_unpack32(&update_cnt, buffer);
+		upd_offset = get_buf_offset(buffer);
+		del.job_cnt = purge_cnt;
+		if (update_cnt) {
+			xrealloc(del.job_ids,
+				 sizeof(uint32_t) * (purge_cnt + update_cnt));
+		}
+		for (i = 0; i < update_cnt; i++) {
+			safe_unpack32(&del.job_ids[del.job_cnt++], buffer);
+			safe_unpack32(&job_len, buffer);
+			set_buf_offset(buffer, get_buf_offset(buffer) + job_len);
+		}
+		if (del.job_cnt) {
+			qsort(del.job_ids, del.job_cnt, sizeof(uint32_t),
+			      _cmp_job_id);
+			list_delete_all(job_list, _list_find_job_ids, &del);
+		}
+		xfree(del.job_ids);
+
+		/* Load the current records of updated jobs */
+		set_buf_offset(buffer, upd_offset);
+		for (i = 0; i < update_cnt; i++) {
+			safe_unpack32(&saved_job_id, buffer);
+			safe_unpack32(&job_len, buffer);
+			if (_load_job_state(buffer, protocol_version))
+				goto unpack_error;
+		}
+		if (get_buf_offset(buffer) != rec_end)
+			goto unpack_error;
+	}
+	if (rec_cnt) {
+		debug("Recovered %d job state journal records", rec_cnt);
+	}
+
+fini:	free_buf(buffer);
+	if (torn && !job_id_only) {
+		/* Drop the incomplete record so later appends follow the
+		 * last complete one */
+		lock_state_files();
+		if (truncate(journal_file, rec_offset))
+			error("Can't truncate %s: %m", journal_file);
+		else
+			info("Truncated job state journal %s at offset %u",
+			     journal_file, rec_offset);
+		unlock_state_files();
+	}
+	xfree(journal_file);
+	return SLURM_SUCCESS;
+
+unpack_error:
+	xfree(del.job_ids);
+	xfree(journal_file);
+	free_buf(buffer);
+	if (!ignore_state_errors)
+		fatal("Invalid job state journal file, start with '-i' to ignore this");
+	error("Invalid job state journal file");
+	return SLURM_ERROR;
+}
+
+/*
+ * _unpack_job_journal_header - read the job_state.journal header
+ * OUT protocol_version - protocol version of the journal records
+ * OUT journal_time - time stamp of the job_state snapshot it follows
+ * OUT write_time - time stamp of the latest write to the journal
+ * RET SLURM_SUCCESS, or SLURM_ERROR if the header is incompatible or short
+ */
+static int _unpack_job_journal_header(Buf buffer, uint16_t *protocol_version,
+				      time_t *journal_time,
+				      time_t *write_time)
+{
+	char *ver_str = NULL;
+	uint32_t ver_str_len;
+
+	*protocol_version = NO_VAL16;
+	safe_unpackstr_xmalloc(&ver_str, &ver_str_len, buffer);
+	if (!ver_str || xstrcmp(ver_str, JOB_STATE_VERSION))
+		goto unpack_error;
+	xfree(ver_str);
+	safe_unpack16(protocol_version, buffer);
+	safe_unpack_time(journal_time, buffer);
+	safe_unpack_time(write_time, buffer);
+	return SLURM_SUCCESS;
+
+unpack_error:
+	xfree(ver_str);
+	*protocol_version = NO_VAL16;
+	return SLURM_ERROR;
+}
+
 static void _pack_acct_policy_limit(acct_policy_limit_set_t *limit_set,
 				    Buf buffer, uint16_t protocol_version)
 {
@@ -2282,33 +2865,19 @@ static int _load_job_state(Buf buffer, uint16_t protocol_version)
 		info("Holding %pJ with invalid association", job_ptr);
 		xfree(job_ptr->state_desc);
 		job_ptr->state_reason = FAIL_ACCOUNT;
+		_record_job_load_acct(job_ptr->job_id, false);
 	} else {
 		job_ptr->assoc_id = assoc_rec.id;
 		info("Recovered %pJ Assoc=%u", job_ptr, job_ptr->assoc_id);
 
-		/* make sure we have started this job in accounting */
-		if (!job_ptr->db_index) {
-			debug("starting %pJ in accounting", job_ptr);
-			if (!with_slurmdbd)
-				jobacct_storage_g_job_start(
-					acct_db_conn, job_ptr);
-			if (slurmctld_init_db
-			    && IS_JOB_SUSPENDED(job_ptr)) {
-				jobacct_storage_g_job_suspend(acct_db_conn,
-							      job_ptr);
-			}
-		}
-		/* make sure we have this job completed in the database */
-		if (IS_JOB_FINISHED(job_ptr)) {
-			if (slurmctld_init_db &&
-			    !(job_ptr->bit_flags & TRES_STR_CALC) &&
-			    job_ptr->tres_alloc_cnt &&
-			    (job_ptr->tres_alloc_cnt[TRES_ENERGY] != NO_VAL64))
-				set_job_tres_alloc_str(job_ptr, false);
-			jobacct_storage_g_job_complete(
-				acct_db_conn, job_ptr);
+		/*
+		 * A job may be loaded from the snapshot and then again from
+		 * several journal records, so it is only synchronized with
+		 * the database once all job state has been recovered.
+		 */
+		_record_job_load_acct(job_ptr->job_id, true);
+		if (IS_JOB_FINISHED(job_ptr))
 			job_finished = 1;
-		}
 	}
 
 	if (!job_finished && job_ptr->qos_id &&
@@ -2766,9 +3335,95 @@ static void _add_job_hash(struct job_record *job_ptr)
 {
 	int inx;
 
+	/* Keep the average hash chain length at no more than one record */
+	if (job_hash_cnt >= hash_table_size)
+		_resize_job_hash(hash_table_size * 2);
+
 	inx = JOB_HASH_INX(job_ptr->job_id);
 	job_ptr->job_next = job_hash[inx];
 	job_hash[inx] = job_ptr;
+	job_hash_cnt++;
+}
+
+/*
+ * Move the records of one hash table into a new one with new_size buckets,
+ * preserving the order of records sharing a bucket
+ * IN old_hash - hash table to empty, xfreed on return
+ * IN old_size - buckets in old_hash
+ * IN new_hash - hash table to fill, with new_size buckets
+ * IN type - which hash to work with
+ */
+static void _rehash_job_table(struct job_record **old_hash, int old_size,
+			      struct job_record **new_hash, int new_size,
+			      job_hash_type_t type)
+{
+	struct job_record *job_ptr, *next_ptr, ***tail_pptr;
+	struct job_record **next_pptr = NULL;
+	int i, inx = 0;
+
+	tail_pptr = xmalloc(sizeof(struct job_record **) * new_size);
+	for (i = 0; i < new_size; i++)
+		tail_pptr[i] = &new_hash[i];
+
+	for (i = 0; i < old_size; i++) {
+		for (job_ptr = old_hash[i]; job_ptr; job_ptr = next_ptr) {
+			switch (type) {
+			case JOB_HASH_JOB:
+				inx = JOB_HASH_INX(job_ptr->job_id);
+				next_pptr = &job_ptr->job_next;
+				break;
+			case JOB_HASH_ARRAY_JOB:
+				inx = JOB_HASH_INX(job_ptr->array_job_id);
+				next_pptr = &job_ptr->job_array_next_j;
+				break;
+			case JOB_HASH_ARRAY_TASK:
+				inx = JOB_ARRAY_HASH_INX(job_ptr->array_job_id,
+							 job_ptr->array_task_id);
+				next_pptr = &job_ptr->job_array_next_t;
+				break;
+			}
+			next_ptr = *next_pptr;
+			*next_pptr = NULL;
+			*tail_pptr[inx] = job_ptr;
+			tail_pptr[inx] = next_pptr;
+		}
+	}
+
+	xfree(tail_pptr);
+	xfree(old_hash);
+}
+
+/*
+ * _resize_job_hash - rebuild the job and job array hash tables with new_size
+ *	buckets, so that lookups stay fast as the job count grows
+ * Globals: hash tables and hash_table_size updated
+ */
+static void _resize_job_hash(int new_size)
+{
+	struct job_record **old_hash, **old_array_hash_j, **old_array_hash_t;
+	int old_size = hash_table_size;
+
+	if (new_size <= old_size)
+		return;
+
+	debug("%s: growing job hash tables from %d to %d entries",
+	      __func__, old_size, new_size);
+
+	old_hash = job_hash;
+	old_array_hash_j = job_array_hash_j;
+	old_array_hash_t = job_array_hash_t;
+
+	hash_table_size = new_size;
+	job_hash = xmalloc(new_size * sizeof(struct job_record *));
+	job_array_hash_j = xmalloc(new_size * sizeof(struct job_record *));
+	job_array_hash_t = xmalloc(new_size * sizeof(struct job_record *));
+
+	_rehash_job_table(old_hash, old_size, job_hash, new_size,
+			  JOB_HASH_JOB);
+	_rehash_job_table(old_array_hash_j, old_size, job_array_hash_j,
+			  new_size, JOB_HASH_ARRAY_JOB);
+	_rehash_job_table(old_array_hash_t, old_size, job_array_hash_t,
+			  new_size, JOB_HASH_ARRAY_TASK);
 }
 
 /* _remove_job_hash - remove a job hash entry for given job record, job_id must
@@ -2818,7 +3473,7 @@ static void _remove_job_hash(struct job_record *job_entry,
 		}
 	}
 
-	if (job_pptr == NULL) {
+	if ((job_pptr == NULL) || (*job_pptr == NULL)) {
 		switch (type) {
 		case JOB_HASH_JOB:
 			error("%s: Could not find hash entry for JobId=%u",
@@ -2842,6 +3497,7 @@ static void _remove_job_hash(struct job_record *job_entry,
 	case JOB_HASH_JOB:
 		*job_pptr = job_entry->job_next;
 		job_entry->job_next = NULL;
+		job_hash_cnt--;
 		break;
 	case JOB_HASH_ARRAY_JOB:
 		*job_pptr = job_entry->job_array_next_j;
@@ -3186,7 +3842,7 @@ static void _rebuild_part_name_list(struct job_record  *job_ptr)
 		xstrcat(job_ptr->partition, part_ptr->name);
 	}
 	list_iterator_destroy(part_iterator);
-	last_job_update = time(NULL);
+	set_job_last_update(job_ptr, time(NULL));
 }
 
 /*
@@ -3406,6 +4062,7 @@ extern int kill_job_by_part_name(char *part_name)
 		}
 		if (IS_JOB_RUNNING(job_ptr) || suspended) {
 			kill_job_cnt++;
+			set_job_last_update(job_ptr, now);
 			info("Killing %pJ on defunct partition %s",
 			     job_ptr, part_name);
 			job_ptr->job_state = JOB_NODE_FAIL | JOB_COMPLETING;
@@ -3424,6 +4081,7 @@ extern int kill_job_by_part_name(char *part_name)
 						 false);
 		} else if (pending) {
 			kill_job_cnt++;
+			set_job_last_update(job_ptr, now);
 			info("Killing %pJ on defunct partition %s",
 			     job_ptr, part_name);
 			job_ptr->job_state	= JOB_CANCELLED;
@@ -3438,8 +4096,6 @@ extern int kill_job_by_part_name(char *part_name)
 	}
 	list_iterator_destroy(job_iterator);
 
-	if (kill_job_cnt)
-		last_job_update = now;
 	return kill_job_cnt;
 }
 
@@ -3491,6 +4147,7 @@ extern int kill_job_by_front_end_name(char *node_name)
 		}
 		if (IS_JOB_COMPLETING(job_ptr)) {
 			kill_job_cnt++;
+			set_job_last_update(job_ptr, now);
 			while ((i = bit_ffs(job_ptr->node_bitmap_cg)) >= 0) {
 				bit_clear(job_ptr->node_bitmap_cg, i);
 				if (job_ptr->node_cnt)
@@ -3513,6 +4170,7 @@ extern int kill_job_by_front_end_name(char *node_name)
 			}
 		} else if (IS_JOB_RUNNING(job_ptr) || suspended) {
 			kill_job_cnt++;
+			set_job_last_update(job_ptr, now);
 			if (job_ptr->batch_flag && job_ptr->details &&
 			    slurmctld_conf.job_requeue &&
 			    (job_ptr->details->requeue > 0)) {
@@ -3608,8 +4266,6 @@ extern int kill_job_by_front_end_name(char *node_name)
 	}
 	list_iterator_destroy(job_iterator);
 
-	if (kill_job_cnt)
-		last_job_update = now;
 	return kill_job_cnt;
 #else
 	return 0;
@@ -3789,6 +4445,7 @@ extern int kill_running_job_by_node_name(char *node_name)
 			if (!bit_test(job_ptr->node_bitmap_cg, node_inx))
 				continue;
 			kill_job_cnt++;
+			set_job_last_update(job_ptr, now);
 			bit_clear(job_ptr->node_bitmap_cg, node_inx);
 			job_update_tres_cnt(job_ptr, node_inx);
 			if (job_ptr->node_cnt)
@@ -3807,6 +4464,7 @@ extern int kill_running_job_by_node_name(char *node_name)
 			}
 		} else if (IS_JOB_RUNNING(job_ptr) || suspended) {
 			kill_job_cnt++;
+			set_job_last_update(job_ptr, now);
 			if ((job_ptr->details) &&
 			    (job_ptr->kill_on_node_fail == 0) &&
 			    (job_ptr->node_cnt > 1) &&
@@ -3918,8 +4576,6 @@ extern int kill_running_job_by_node_name(char *node_name)
 
 	}
 	list_iterator_destroy(job_iterator);
-	if (kill_job_cnt)
-		last_job_update = now;
 
 	return kill_job_cnt;
 }
@@ -4231,6 +4887,8 @@ int init_job_conf(void)
 
 /*
  * rehash_jobs - Create or rebuild the job hash table.
+ * The tables also grow automatically as job records are added, this just
+ * avoids repeated rebuilds as the job count rises towards MaxJobCount.
  */
 extern void rehash_jobs(void)
 {
@@ -4238,20 +4896,15 @@ extern void rehash_jobs(void)
 	xassert(verify_lock(JOB_LOCK, WRITE_LOCK));
 
 	if (job_hash == NULL) {
-		hash_table_size = slurmctld_conf.max_job_cnt;
+		hash_table_size = MAX(slurmctld_conf.max_job_cnt, 1);
 		job_hash = (struct job_record **)
 			xmalloc(hash_table_size * sizeof(struct job_record *));
 		job_array_hash_j = (struct job_record **)
 			xmalloc(hash_table_size * sizeof(struct job_record *));
 		job_array_hash_t = (struct job_record **)
 			xmalloc(hash_table_size * sizeof(struct job_record *));
-	} else if (hash_table_size < (slurmctld_conf.max_job_cnt / 2)) {
-		/* If the MaxJobCount grows by too much, the hash table will
-		 * be ineffective without rebuilding. We don't presently bother
-		 * to rebuild the hash table, but cut MaxJobCount back as
-		 * needed. */
-		error ("MaxJobCount reset too high, restart slurmctld");
-		slurmctld_conf.max_job_cnt = hash_table_size;
+	} else if (hash_table_size < slurmctld_conf.max_job_cnt) {
+		_resize_job_hash(slurmctld_conf.max_job_cnt);
 	}
 }
 
@@ -4302,6 +4955,10 @@ extern struct job_record *job_array_split(struct job_record *job_ptr)
 	job_ptr_pend->db_index = save_db_index;
 
 	job_ptr_pend->prio_factors = save_prio_factors;
+	job_ptr_pend->state_rec = NULL;
+	job_ptr_pend->state_rec_len = 0;
+	set_job_last_update(job_ptr_pend, time(NULL));
+	set_job_last_update(job_ptr, job_ptr_pend->last_update);
 	slurm_copy_priority_factors_object(job_ptr_pend->prio_factors,
 					   job_ptr->prio_factors);
 
@@ -4883,7 +5540,7 @@ extern int job_allocate(job_desc_msg_t * job_specs, int immediate,
 
 	error_code = _select_nodes_parts(job_ptr, no_alloc, NULL, err_msg);
 	if (!test_only) {
-		last_job_update = now;
+		set_job_last_update(job_ptr, now);
 	}
 
        /*
@@ -4998,7 +5655,7 @@ static int _job_fail(struct job_record *job_ptr, uint32_t job_state)
 				difftime(now, job_ptr->suspend_time);
 		} else
 			job_ptr->end_time       = now;
-		last_job_update                 = now;
+		set_job_last_update(job_ptr, now);
 		job_ptr->job_state = job_state | JOB_COMPLETING;
 		job_ptr->exit_code = 1;
 		job_ptr->state_reason = FAIL_LAUNCH;
@@ -5122,7 +5779,7 @@ extern int job_signal(struct job_record *job_ptr, uint16_t signal,
 
 	/* let node select plugin do any state-dependent signaling actions */
 	select_g_job_signal(job_ptr, signal);
-	last_job_update = now;
+	set_job_last_update(job_ptr, now);
 
 	/* save user ID of the one who requested the job be cancelled */
 	if (signal == SIGKILL)
@@ -5141,7 +5798,7 @@ extern int job_signal(struct job_record *job_ptr, uint16_t signal,
 		job_ptr->bit_flags |= JOB_KILL_HURRY;
 
 	if (IS_JOB_CONFIGURING(job_ptr) && (signal == SIGKILL)) {
-		last_job_update         = now;
+		set_job_last_update(job_ptr, now);
 		job_ptr->end_time       = now;
 		job_ptr->job_state      = JOB_CANCELLED | JOB_COMPLETING;
 		if (flags & KILL_FED_REQUEUE)
@@ -5185,7 +5842,7 @@ extern int job_signal(struct job_record *job_ptr, uint16_t signal,
 	else
 		job_term_state = JOB_CANCELLED;
 	if (IS_JOB_SUSPENDED(job_ptr) && (signal == SIGKILL)) {
-		last_job_update         = now;
+		set_job_last_update(job_ptr, now);
 		job_ptr->end_time       = job_ptr->suspend_time;
 		job_ptr->tot_sus_time  += difftime(now, job_ptr->suspend_time);
 		job_ptr->job_state      = job_term_state | JOB_COMPLETING;
@@ -5221,7 +5878,7 @@ extern int job_signal(struct job_record *job_ptr, uint16_t signal,
 			 */
 			job_ptr->time_last_active	= now;
 			job_ptr->end_time		= now;
-			last_job_update			= now;
+			set_job_last_update(job_ptr, now);
 			job_ptr->job_state = job_term_state | JOB_COMPLETING;
 			if (flags & KILL_FED_REQUEUE)
 				job_ptr->job_state |= JOB_REQUEUE;
@@ -5542,11 +6199,12 @@ extern int job_str_signal(char *job_id_str, uint16_t signal, uint16_t flags,
 			bit_and_not(job_ptr->array_recs->task_id_bitmap,
 				array_bitmap);
 			xfree(job_ptr->array_recs->task_id_str);
+			set_job_last_update(job_ptr, now);
 			orig_task_cnt = job_ptr->array_recs->task_cnt;
 			new_task_count = bit_set_count(job_ptr->array_recs->
 						       task_id_bitmap);
 			if (!new_task_count) {
-				last_job_update		= now;
+				set_job_last_update(job_ptr, now);
 				job_ptr->job_state	= JOB_CANCELLED;
 				job_ptr->start_time	= now;
 				job_ptr->end_time	= now;
@@ -5887,7 +6545,7 @@ static int _job_complete(struct job_record *job_ptr, uid_t uid, bool requeue,
 		job_completion_logger(job_ptr, false);
 	}
 
-	last_job_update = now;
+	set_job_last_update(job_ptr, now);
 	job_ptr->time_last_active = now;   /* Timer for resending kill RPC */
 	if (job_comp_flag) {	/* job was running */
 		build_cg_bitmap(job_ptr);
@@ -7559,6 +8217,7 @@ _read_data_array_from_file(int fd, char *file_name, char ***data,
 	int pos, buf_size, amount, i, j;
 	char *buffer, **array_ptr;
 	uint32_t rec_cnt;
+	struct stat stat_buf;
 
 	xassert(file_name);
 	xassert(data);
@@ -7587,22 +8246,34 @@ _read_data_array_from_file(int fd, char *file_name, char ***data,
 		return 0;
 	}
 
+	/*
+	 * Size the buffer from the file so it is normally read at once,
+	 * with one spare byte so that end of file is seen without growing it
+	 */
 	pos = 0;
 	buf_size = BUF_SIZE;
+	if ((fstat(fd, &stat_buf) == 0) &&
+	    (stat_buf.st_size > sizeof(uint32_t)) &&
+	    (stat_buf.st_size < INT_MAX))
+		buf_size = stat_buf.st_size - sizeof(uint32_t) + 1;
 	buffer = xmalloc(buf_size + 1);
 	while (1) {
-		amount = read(fd, &buffer[pos], BUF_SIZE);
+		amount = read(fd, &buffer[pos], buf_size - pos);
 		if (amount < 0) {
+			if (errno == EINTR)
+				continue;
 			error("Error reading file %s, %m", file_name);
 			xfree(buffer);
 			return -1;
 		}
-		buffer[pos + amount] = '\0';
 		pos += amount;
-		if (amount < BUF_SIZE)	/* end of file */
+		buffer[pos] = '\0';
+		if (amount == 0)	/* end of file */
 			break;
-		buf_size += amount;
-		xrealloc(buffer, buf_size + 1);
+		if (pos == buf_size) {	/* file is larger, keep reading */
+			buf_size += BUF_SIZE;
+			xrealloc(buffer, buf_size + 1);
+		}
 	}
 
 	/* Allocate extra space for supplemental environment variables */
@@ -8349,7 +9020,7 @@ extern void job_config_fini(struct job_record *job_ptr)
 {
 	time_t now = time(NULL);
 
-	last_job_update = now;
+	set_job_last_update(job_ptr, now);
 	job_ptr->job_state &= ~JOB_CONFIGURING;
 	if (IS_JOB_POWER_UP_NODE(job_ptr)) {
 		info("Resetting %pJ start time for node power up", job_ptr);
@@ -8523,7 +9194,7 @@ void job_time_limit(void)
 		    IS_JOB_PENDING(job_ptr) && (job_ptr->priority == 0)) {
 			job_ptr->state_reason = WAIT_NO_REASON;
 			set_job_prio(job_ptr);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 		}
 
 		if (_pack_configuring_test(job_ptr))
@@ -8553,7 +9224,7 @@ void job_time_limit(void)
 				job_ptr->warn_flags |= WARN_SENT;
 			}
 			if (job_ptr->end_time <= now) {
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 				info("%s: Preemption GraceTime reached %pJ",
 				     __func__, job_ptr);
 				job_ptr->job_state = JOB_PREEMPTED |
@@ -8636,7 +9307,7 @@ void job_time_limit(void)
 			else
 				over_run = now - (over_time_limit  * 60);
 			if (job_ptr->end_time <= over_run) {
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 				info("Time limit exhausted for %pJ", job_ptr);
 				_job_timed_out(job_ptr, false);
 				job_ptr->state_reason = FAIL_TIMEOUT;
@@ -8648,7 +9319,7 @@ void job_time_limit(void)
 		if (job_ptr->resv_ptr &&
 		    !(job_ptr->resv_ptr->flags & RESERVE_FLAG_FLEX) &&
 		    (job_ptr->resv_ptr->end_time + resv_over_run) < time(NULL)){
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			info("Reservation ended for %pJ", job_ptr);
 			_job_timed_out(job_ptr, false);
 			job_ptr->state_reason = FAIL_TIMEOUT;
@@ -8667,7 +9338,7 @@ void job_time_limit(void)
 		acct_policy_job_time_out(job_ptr);
 
 		if (job_ptr->state_reason == FAIL_TIMEOUT) {
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			_job_timed_out(job_ptr, false);
 			xfree(job_ptr->state_desc);
 			goto time_check;
@@ -9125,6 +9796,12 @@ static void _list_delete_job(void *job_entry)
 	/* Remove record from fed_job_list */
 	fed_mgr_remove_fed_job_info(job_ptr->job_id);
 
+	/* Report the removal in later job info deltas */
+	_record_job_purge(job_ptr->job_id);
+
+	/* Report the removal in the next job state journal record */
+	_record_job_journal_purge(job_ptr->job_id);
+
 	/* Remove the record from job hash table */
 	_remove_job_hash(job_ptr, JOB_HASH_JOB);
 
@@ -9145,6 +9822,7 @@ static void _list_delete_job(void *job_entry)
 	xfree(job_ptr->admin_comment);
 	xfree(job_ptr->alias_list);
 	xfree(job_ptr->alloc_node);
+	xfree(job_ptr->state_rec);
 	if (job_ptr->array_recs) {
 		FREE_NULL_BITMAP(job_ptr->array_recs->task_id_bitmap);
 		xfree(job_ptr->array_recs->task_id_str);
@@ -9377,21 +10055,31 @@ static bool _hide_job(struct job_record *job_ptr, uid_t uid,
 	return false;
 }
 
-static void _pack_job(struct job_record *job_ptr,
-		      _foreach_pack_job_info_t *pack_info)
+/* Determine if a job should be included in a job info response */
+static bool _is_job_packable(struct job_record *job_ptr,
+			     _foreach_pack_job_info_t *pack_info)
 {
-	xassert (job_ptr->magic == JOB_MAGIC);
-
 	if ((pack_info->filter_uid != NO_VAL) &&
 	    (pack_info->filter_uid != job_ptr->user_id))
-		return;
+		return false;
 
 	if (((pack_info->show_flags & SHOW_ALL) == 0) &&
 	    (pack_info->uid != 0) &&
 	    _all_parts_hidden(job_ptr, pack_info->uid))
-		return;
+		return false;
 
 	if (_hide_job(job_ptr, pack_info->uid, pack_info->show_flags))
+		return false;
+
+	return true;
+}
+
+static void _pack_job(struct job_record *job_ptr,
+		      _foreach_pack_job_info_t *pack_info)
+{
+	xassert (job_ptr->magic == JOB_MAGIC);
+
+	if (!_is_job_packable(job_ptr, pack_info))
 		return;
 
 	pack_job(job_ptr, pack_info->show_flags, pack_info->buffer,
@@ -9414,6 +10102,126 @@ static int _foreach_pack_jobid(void *object, void *arg)
 	return SLURM_SUCCESS;
 }
 
+/*
+ * Return true if no job, partition or configuration change has been recorded
+ * since before the given cache entry was built. Changes made in the second
+ * the entry was built can not be distinguished from earlier ones, so such an
+ * entry is never reused.
+ */
+static bool _job_info_cache_valid(job_info_cache_t *cache, time_t now)
+{
+	if (!cache->buffer)
+		return false;
+	if ((now - cache->build_time) >= JOB_INFO_CACHE_AGE)
+		return false;
+	if ((cache->job_update  != last_job_update) ||
+	    (cache->part_update != last_part_update) ||
+	    (cache->conf_update != slurmctld_conf.last_update))
+		return false;
+	if ((cache->job_update  >= cache->build_time) ||
+	    (cache->part_update >= cache->build_time) ||
+	    (cache->conf_update >= cache->build_time))
+		return false;
+	return true;
+}
+
+/* Drop a reference to a response buffer, call with job_info_cache_mutex */
+static void _job_info_buf_unref(char *buffer)
+{
+	job_info_buf_t *buf_hdr;
+
+	if (!buffer)
+		return;
+	buf_hdr = (job_info_buf_t *) (buffer - sizeof(job_info_buf_t));
+	if (--buf_hdr->ref_cnt == 0)
+		xfree(buf_hdr);
+}
+
+/*
+ * Share a cached pack_all_jobs() response for an identical request,
+ * avoiding a walk and re-pack of every job record.
+ * RET true if a cached response was found
+ */
+static bool _get_job_info_cache(char **buffer_ptr, int *buffer_size,
+				time_t now, uint16_t show_flags, uid_t uid,
+				uint32_t filter_uid, uint16_t protocol_version)
+{
+	job_info_cache_t *cache;
+	job_info_buf_t *buf_hdr;
+	bool found = false;
+	int i;
+
+	slurm_mutex_lock(&job_info_cache_mutex);
+	for (i = 0; i < JOB_INFO_CACHE_CNT; i++) {
+		cache = &job_info_cache[i];
+		if (!_job_info_cache_valid(cache, now)) {
+			/* Stale, don't keep it in memory */
+			_job_info_buf_unref(cache->buffer);
+			cache->buffer = NULL;
+			continue;
+		}
+		if ((cache->show_flags != show_flags) ||
+		    (cache->uid != uid) ||
+		    (cache->filter_uid != filter_uid) ||
+		    (cache->protocol_version != protocol_version))
+			continue;
+		buf_hdr = (job_info_buf_t *)
+			  (cache->buffer - sizeof(job_info_buf_t));
+		buf_hdr->ref_cnt++;
+		*buffer_ptr = cache->buffer;
+		*buffer_size = cache->buffer_size;
+		found = true;
+		break;
+	}
+	slurm_mutex_unlock(&job_info_cache_mutex);
+
+	return found;
+}
+
+/* Keep a reference to a pack_all_jobs() response for reuse */
+static void _set_job_info_cache(char *buffer, int buffer_size, time_t now,
+				uint16_t show_flags, uid_t uid,
+				uint32_t filter_uid, uint16_t protocol_version)
+{
+	job_info_cache_t *cache;
+	job_info_buf_t *buf_hdr;
+
+	/* The response could not be reused */
+	if ((last_job_update >= now) || (last_part_update >= now) ||
+	    (slurmctld_conf.last_update >= now))
+		return;
+
+	slurm_mutex_lock(&job_info_cache_mutex);
+	cache = &job_info_cache[job_info_cache_next];
+	job_info_cache_next = (job_info_cache_next + 1) % JOB_INFO_CACHE_CNT;
+
+	_job_info_buf_unref(cache->buffer);
+	buf_hdr = (job_info_buf_t *) (buffer - sizeof(job_info_buf_t));
+	buf_hdr->ref_cnt++;
+	cache->buffer		= buffer;
+	cache->buffer_size	= buffer_size;
+	cache->build_time	= now;
+	cache->conf_update	= slurmctld_conf.last_update;
+	cache->filter_uid	= filter_uid;
+	cache->job_update	= last_job_update;
+	cache->part_update	= last_part_update;
+	cache->protocol_version	= protocol_version;
+	cache->show_flags	= show_flags;
+	cache->uid		= uid;
+	slurm_mutex_unlock(&job_info_cache_mutex);
+}
+
+/*
+ * free_job_info_buf - release a buffer returned by pack_all_jobs()
+ * IN buffer - the buffer at *buffer_ptr set by pack_all_jobs()
+ */
+extern void free_job_info_buf(char *buffer)
+{
+	slurm_mutex_lock(&job_info_cache_mutex);
+	_job_info_buf_unref(buffer);
+	slurm_mutex_unlock(&job_info_cache_mutex);
+}
+
 /*
  * pack_all_jobs - dump all job information for all jobs in
  *	machine independent form (for network transmission)
@@ -9423,7 +10231,8 @@ static int _foreach_pack_jobid(void *object, void *arg)
  * IN uid - uid of user making request (for partition filtering)
  * IN filter_uid - pack only jobs belonging to this user if not NO_VAL
  * global: job_list - global list of job records
- * NOTE: the buffer at *buffer_ptr must be xfreed by the caller
+ * NOTE: the buffer at *buffer_ptr may be shared with other requests, it must
+ *	not be modified and must be released with free_job_info_buf()
  * NOTE: change _unpack_job_desc_msg() in common/slurm_protocol_pack.c
  *	whenever the data format changes
  */
@@ -9436,16 +10245,25 @@ extern void pack_all_jobs(char **buffer_ptr, int *buffer_size,
 	Buf buffer;
 	ListIterator itr;
 	struct job_record *job_ptr = NULL;
+	job_info_buf_t *buf_hdr;
+	time_t now = time(NULL);
 
 	buffer_ptr[0] = NULL;
 	*buffer_size = 0;
 
+	if (_get_job_info_cache(buffer_ptr, buffer_size, now, show_flags, uid,
+				filter_uid, protocol_version))
+		return;
+
 	buffer = init_buf(BUF_SIZE);
 
+	/* leave room for the reference count shared with the cache */
+	set_buf_offset(buffer, sizeof(job_info_buf_t));
+
 	/* write message body header : size and time */
 	/* put in a place holder job record count of 0 for now */
 	pack32(jobs_packed, buffer);
-	pack_time(time(NULL), buffer);
+	pack_time(now, buffer);
 
 	/* write individual job records */
 	pack_info.buffer           = buffer;
@@ -9461,6 +10279,141 @@ extern void pack_all_jobs(char **buffer_ptr, int *buffer_size,
 	}
 	list_iterator_destroy(itr);
 
+	/* put the real record count in the message body header */
+	tmp_offset = get_buf_offset(buffer);
+	set_buf_offset(buffer, sizeof(job_info_buf_t));
+	pack32(jobs_packed, buffer);
+	set_buf_offset(buffer, tmp_offset);
+
+	*buffer_size = get_buf_offset(buffer) - sizeof(job_info_buf_t);
+	buf_hdr = (job_info_buf_t *) xfer_buf_data(buffer);
+	buf_hdr->ref_cnt = 1;
+	buffer_ptr[0] = (char *) (buf_hdr + 1);
+
+	_set_job_info_cache(*buffer_ptr, *buffer_size, now, show_flags, uid,
+			    filter_uid, protocol_version);
+}
+
+/* Record a job's removal from job_list for the job state journal */
+static void _record_job_journal_purge(uint32_t job_id)
+{
+	/* The next save writes a full snapshot, nothing to record */
+	if (!job_journal_valid)
+		return;
+
+	if (job_journal_purge_cnt >= job_journal_purge_size) {
+		job_journal_purge_size = MAX(1024, job_journal_purge_size * 2);
+		xrealloc(job_journal_purge,
+			 sizeof(uint32_t) * job_journal_purge_size);
+	}
+	job_journal_purge[job_journal_purge_cnt++] = job_id;
+}
+
+/* Record a job's removal from job_list for use in job info deltas */
+static void _record_job_purge(uint32_t job_id)
+{
+	job_purge_rec_t *purge_rec = &job_purge_hist[job_purge_hist_next];
+
+	if (purge_rec->purge_time)
+		job_purge_hist_lost = purge_rec->purge_time;
+	purge_rec->job_id = job_id;
+	purge_rec->purge_time = time(NULL);
+	job_purge_hist_next = (job_purge_hist_next + 1) % JOB_PURGE_HIST_CNT;
+}
+
+/*
+ * pack_delta_jobs - dump job information for jobs changed since update_time
+ *	in machine independent form (for network transmission), followed by
+ *	the IDs of jobs purged or hidden since then
+ * OUT buffer_ptr - the pointer is set to the allocated buffer.
+ * OUT buffer_size - set to size of the buffer in bytes
+ * IN update_time - time of the client's prior response
+ * IN show_flags - job filtering options
+ * IN uid - uid of user making request (for partition filtering)
+ * IN protocol_version - slurm protocol version of client
+ * RET SLURM_SUCCESS or SLURM_ERROR if no delta can be built, in which case
+ *	pack_all_jobs() must be used
+ * global: job_list - global list of job records
+ * NOTE: the buffer at *buffer_ptr must be xfreed by the caller
+ */
+extern int pack_delta_jobs(char **buffer_ptr, int *buffer_size,
+			   time_t update_time, uint16_t show_flags, uid_t uid,
+			   uint16_t protocol_version)
+{
+	uint32_t jobs_packed = 0, removed_cnt = 0, removed_size = 0;
+	uint32_t *removed_ids = NULL, tmp_offset;
+	_foreach_pack_job_info_t pack_info = {0};
+	Buf buffer;
+	ListIterator itr;
+	struct job_record *job_ptr;
+	time_t now = time(NULL);
+	int i;
+
+	buffer_ptr[0] = NULL;
+	*buffer_size = 0;
+
+	if (protocol_version < SLURM_19_05_PROTOCOL_VERSION)
+		return SLURM_ERROR;
+
+	/*
+	 * Changes made in the second of update_time may precede or follow
+	 * the client's prior response, so treat them as later changes.
+	 * Partition and configuration changes can alter the visibility of
+	 * any job, so those always require a full response.
+	 */
+	if ((update_time <= slurmctld_config.boot_time) ||
+	    (update_time <= job_purge_hist_lost) ||
+	    (update_time <= last_part_update) ||
+	    (update_time <= slurmctld_conf.last_update))
+		return SLURM_ERROR;
+
+	buffer = init_buf(BUF_SIZE);
+
+	/* write message body header : size and time */
+	/* put in a place holder job record count of 0 for now */
+	pack32(jobs_packed, buffer);
+	pack_time(now, buffer);
+
+	/* write individual job records */
+	pack_info.buffer           = buffer;
+	pack_info.filter_uid       = NO_VAL;
+	pack_info.jobs_packed      = &jobs_packed;
+	pack_info.protocol_version = protocol_version;
+	pack_info.show_flags       = show_flags;
+	pack_info.uid              = uid;
+
+	itr = list_iterator_create(job_list);
+	while ((job_ptr = (struct job_record *) list_next(itr))) {
+		if (job_ptr->last_update < update_time)
+			continue;
+		if (_is_job_packable(job_ptr, &pack_info)) {
+			pack_job(job_ptr, show_flags, buffer, protocol_version,
+				 uid);
+			jobs_packed++;
+			continue;
+		}
+		/* The client may hold an older, visible copy of the job */
+		if (removed_cnt >= removed_size) {
+			removed_size += 64;
+			xrealloc(removed_ids, sizeof(uint32_t) * removed_size);
+		}
+		removed_ids[removed_cnt++] = job_ptr->job_id;
+	}
+	list_iterator_destroy(itr);
+
+	for (i = 0; i < JOB_PURGE_HIST_CNT; i++) {
+		if (job_purge_hist[i].purge_time < update_time)
+			continue;
+		if (removed_cnt >= removed_size) {
+			removed_size += 64;
+			xrealloc(removed_ids, sizeof(uint32_t) * removed_size);
+		}
+		removed_ids[removed_cnt++] = job_purge_hist[i].job_id;
+	}
+
+	pack32_array(removed_ids, removed_cnt, buffer);
+	xfree(removed_ids);
+
 	/* put the real record count in the message body header */
 	tmp_offset = get_buf_offset(buffer);
 	set_buf_offset(buffer, 0);
@@ -9469,6 +10422,8 @@ extern void pack_all_jobs(char **buffer_ptr, int *buffer_size,
 
 	*buffer_size = get_buf_offset(buffer);
 	buffer_ptr[0] = xfer_buf_data(buffer);
+
+	return SLURM_SUCCESS;
 }
 
 /*
@@ -10639,6 +11594,7 @@ void reset_job_bitmaps(void)
 			error("select_g_select_nodeinfo_set(%pJ): %m",
 			      job_ptr);
 		}
+		set_job_last_update(job_ptr, now);
 	}
 	list_iterator_destroy(job_iterator);
 
@@ -10777,6 +11733,19 @@ static int _set_job_id(struct job_record *job_ptr)
 }
 
 
+/*
+ * set_job_last_update - note a change to a job's information, used to
+ *	build job info deltas
+ * IN job_ptr - pointer to the job_record
+ * IN now - time of the change
+ * global: last_job_update - time of last job table update
+ */
+extern void set_job_last_update(struct job_record *job_ptr, time_t now)
+{
+	job_ptr->last_update = now;
+	last_job_update = now;
+}
+
 /*
  * set_job_prio - set a default job priority
  * IN job_ptr - pointer to the job_record
@@ -11160,7 +12129,7 @@ static int _update_job(struct job_record *job_ptr, job_desc_msg_t * job_specs,
 		if (IS_JOB_COMPLETED(job_ptr) && operator &&
 		    (job_specs->burst_buffer[0] == '\0')) {
 			xfree(job_ptr->burst_buffer);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 		} else {
 			error_code = ESLURM_NOT_SUPPORTED;
 		}
@@ -11235,7 +12204,7 @@ static int _update_job(struct job_record *job_ptr, job_desc_msg_t * job_specs,
 	detail_ptr = job_ptr->details;
 	if (detail_ptr)
 		mc_ptr = detail_ptr->mc_ptr;
-	last_job_update = now;
+	set_job_last_update(job_ptr, now);
 
 	/*
 	 * Check to see if the new requested job_specs exceeds any
@@ -13478,6 +14447,7 @@ static void _send_job_kill(struct job_record *job_ptr)
 				node_ptr->protocol_version;
 		hostlist_push_host(agent_args->hostlist, node_ptr->name);
 		agent_args->node_count++;
+		set_node_last_update(node_ptr, last_node_update);
 	}
 #endif
 	if (agent_args->node_count == 0) {
@@ -14008,7 +14978,7 @@ extern int job_alloc_info_ptr(uint32_t uid, struct job_record *job_ptr)
 	if (job_ptr->alias_list && !xstrcmp(job_ptr->alias_list, "TBD") &&
 	    (prolog == 0) && job_ptr->node_bitmap &&
 	    (bit_overlap(power_node_bitmap, job_ptr->node_bitmap) == 0)) {
-		last_job_update = time(NULL);
+		set_job_last_update(job_ptr, time(NULL));
 		set_job_alias_list(job_ptr);
 	}
 
@@ -14484,10 +15454,18 @@ void batch_requeue_fini(struct job_record  *job_ptr)
 /* job_fini - free all memory associated with job records */
 void job_fini (void)
 {
+	int i;
+
 	FREE_NULL_LIST(job_list);
 	xfree(job_hash);
 	xfree(job_array_hash_j);
 	xfree(job_array_hash_t);
+	slurm_mutex_lock(&job_info_cache_mutex);
+	for (i = 0; i < JOB_INFO_CACHE_CNT; i++) {
+		_job_info_buf_unref(job_info_cache[i].buffer);
+		job_info_cache[i].buffer = NULL;
+	}
+	slurm_mutex_unlock(&job_info_cache_mutex);
 	FREE_NULL_LIST(purge_files_list);
 	FREE_NULL_BITMAP(requeue_exit);
 	FREE_NULL_BITMAP(requeue_exit_hold);
@@ -14832,7 +15810,7 @@ extern int job_node_ready(uint32_t job_id, int *ready)
 	    job_ptr->alias_list && !xstrcmp(job_ptr->alias_list, "TBD") &&
 	    job_ptr->node_bitmap &&
 	    (bit_overlap(power_node_bitmap, job_ptr->node_bitmap) == 0)) {
-		last_job_update = time(NULL);
+		set_job_last_update(job_ptr, time(NULL));
 		set_job_alias_list(job_ptr);
 	}
 
@@ -15084,8 +16062,9 @@ static int _suspend_job_nodes(struct job_record *job_ptr, bool indf_susp)
 			node_ptr->node_state = NODE_STATE_IDLE | node_flags;
 			node_ptr->last_idle  = now;
 		}
+		set_node_last_update(node_ptr, now);
 	}
-	last_job_update = last_node_update = now;
+	set_job_last_update(job_ptr, now);
 	return rc;
 }
 
@@ -15100,6 +16079,7 @@ static int _resume_job_nodes(struct job_record *job_ptr, bool indf_susp)
 	int i, i_first, i_last, rc = SLURM_SUCCESS;
 	struct node_record *node_ptr;
 	uint32_t node_flags;
+	time_t now = time(NULL);
 
 	if ((rc = select_g_job_resume(job_ptr, indf_susp)) != SLURM_SUCCESS)
 		return rc;
@@ -15138,8 +16118,9 @@ static int _resume_job_nodes(struct job_record *job_ptr, bool indf_susp)
 		bit_clear(idle_node_bitmap, i);
 		node_flags = node_ptr->node_state & NODE_STATE_FLAGS;
 		node_ptr->node_state = NODE_STATE_ALLOCATED | node_flags;
+		set_node_last_update(node_ptr, now);
 	}
-	last_job_update = last_node_update = time(NULL);
+	set_job_last_update(job_ptr, now);
 	return rc;
 }
 
@@ -15614,7 +16595,7 @@ static int _job_requeue_op(uid_t uid, struct job_record *job_ptr, bool preempt,
 			return SLURM_SUCCESS;
 	}
 
-	last_job_update = now;
+	set_job_last_update(job_ptr, now);
 
 	/*
 	 * In the job is in the process of completing
@@ -16034,6 +17015,7 @@ static int _set_top(List top_job_list, uid_t uid)
 	int64_t delta_prio, delta_nice, total_delta = 0;
 	int other_job_cnt = 0;
 	uint32_t *prio_elem;
+	time_t now = time(NULL);
 
 	xassert(job_list);
 	xassert(top_job_list);
@@ -16138,6 +17120,7 @@ static int _set_top(List top_job_list, uid_t uid)
 		job_ptr->priority = next_prio;
 		job_ptr->details->nice -= delta_nice;
 		job_ptr->bit_flags &= (~TOP_PRIO_TMP);
+		set_job_last_update(job_ptr, now);
 	}
 	list_iterator_destroy(iter);
 	FREE_NULL_LIST(prio_list);
@@ -16156,6 +17139,7 @@ static int _set_top(List top_job_list, uid_t uid)
 			job_ptr->priority = next_prio;
 			job_ptr->details->nice += delta_nice;
 			job_ptr->bit_flags &= (~TOP_PRIO_TMP);
+			set_job_last_update(job_ptr, now);
 			total_delta -= delta_nice;
 			if (--other_job_cnt == 0)
 				break;	/* Count will match list size anyway */
@@ -16164,7 +17148,7 @@ static int _set_top(List top_job_list, uid_t uid)
 	}
 	FREE_NULL_LIST(other_job_list);
 
-	last_job_update = time(NULL);
+	last_job_update = now;
 
 	return rc;
 }
@@ -16485,7 +17469,7 @@ extern int update_job_wckey(char *module, struct job_record *job_ptr,
 		info("%s: cleared wckey for %pJ", module, job_ptr);
 	}
 
-	last_job_update = time(NULL);
+	set_job_last_update(job_ptr, time(NULL));
 
 	return SLURM_SUCCESS;
 }
@@ -16610,7 +17594,7 @@ extern int job_checkpoint(checkpoint_msg_t *ckpt_ptr, uid_t uid,
 				   &resp_data.error_msg);
 		info("checkpoint_op %u of JobId=%u.%u complete, rc=%d",
 		     ckpt_ptr->op, ckpt_ptr->job_id, ckpt_ptr->step_id, rc);
-		last_job_update = time(NULL);
+		set_job_last_update(job_ptr, time(NULL));
 	} else {		/* operate on all of a job's steps */
 		int update_rc = -2;
 		ListIterator step_iterator;
@@ -16644,7 +17628,7 @@ extern int job_checkpoint(checkpoint_msg_t *ckpt_ptr, uid_t uid,
 			xfree(image_dir);
 		}
 		if (update_rc != -2)	/* some work done */
-			last_job_update = time(NULL);
+			set_job_last_update(job_ptr, time(NULL));
 		list_iterator_destroy (step_iterator);
 	}
 
@@ -17053,7 +18037,7 @@ extern int job_restart(checkpoint_msg_t *ckpt_ptr, uid_t uid, int conn_fd,
 		job_ptr->details->restart_dir = image_dir;
 		image_dir = NULL;	/* Nothing left to xfree */
 
-		last_job_update = time(NULL);
+		set_job_last_update(job_ptr, time(NULL));
 	}
 
  unpack_error:
@@ -17445,7 +18429,7 @@ _kill_dependent(struct job_record *job_ptr)
 	job_ptr->start_time = now;
 	job_ptr->end_time = now;
 	job_completion_logger(job_ptr, false);
-	last_job_update = now;
+	set_job_last_update(job_ptr, now);
 	srun_allocate_abort(job_ptr);
 }
 
@@ -111,12 +111,24 @@ typedef struct wait_boot_arg {
 	bitstr_t *node_bitmap;
 } wait_boot_arg_t;
 
+/*
+ * Job queue records in a binary heap, highest priority (as ordered by
+ * sort_job_queue2()) at the root
+ */
+typedef struct job_queue_heap {
+	job_queue_rec_t **rec;
+	int rec_cnt;
+} job_queue_heap_t;
+
 static char **	_build_env(struct job_record *job_ptr, bool is_epilog);
 static batch_job_launch_msg_t *_build_launch_job_msg(struct job_record *job_ptr,
 						     uint16_t protocol_version);
 static void	_depend_list_del(void *dep_ptr);
 static void	_job_queue_append(List job_queue, struct job_record *job_ptr,
 				  struct part_record *part_ptr, uint32_t priority);
+static void	_job_queue_heap_build(job_queue_heap_t *heap, List job_queue);
+static void	_job_queue_heap_free(job_queue_heap_t *heap);
+static job_queue_rec_t *_job_queue_heap_pop(job_queue_heap_t *heap);
 static void	_job_queue_rec_del(void *x);
 static bool	_job_runnable_test1(struct job_record *job_ptr,
 				    bool clear_start);
@@ -248,6 +260,64 @@ static void _job_queue_rec_del(void *x)
 	xfree(x);
 }
 
+static void _job_queue_heap_sift_down(job_queue_heap_t *heap, int inx)
+{
+	job_queue_rec_t *tmp;
+	int child;
+
+	while ((child = (2 * inx) + 1) < heap->rec_cnt) {
+		if (((child + 1) < heap->rec_cnt) &&
+		    (sort_job_queue2(&heap->rec[child + 1],
+				     &heap->rec[child]) < 0))
+			child++;
+		if (sort_job_queue2(&heap->rec[child], &heap->rec[inx]) >= 0)
+			break;
+		tmp = heap->rec[inx];
+		heap->rec[inx] = heap->rec[child];
+		heap->rec[child] = tmp;
+		inx = child;
+	}
+}
+
+/*
+ * Move the records of a job queue from build_job_queue() into a heap.
+ * Building the heap takes linear time, so a scheduling pass only pays to
+ * order the jobs it actually pops rather than sorting the whole queue.
+ */
+static void _job_queue_heap_build(job_queue_heap_t *heap, List job_queue)
+{
+	job_queue_rec_t *job_queue_rec;
+	int i;
+
+	heap->rec_cnt = 0;
+	heap->rec = xmalloc(sizeof(job_queue_rec_t *) *
+			    MAX(1, list_count(job_queue)));
+	while ((job_queue_rec = list_pop(job_queue)))
+		heap->rec[heap->rec_cnt++] = job_queue_rec;
+	for (i = (heap->rec_cnt / 2) - 1; i >= 0; i--)
+		_job_queue_heap_sift_down(heap, i);
+}
+
+/* Remove and return the highest priority record, NULL if heap is empty */
+static job_queue_rec_t *_job_queue_heap_pop(job_queue_heap_t *heap)
+{
+	job_queue_rec_t *job_queue_rec;
+
+	if (heap->rec_cnt == 0)
+		return NULL;
+	job_queue_rec = heap->rec[0];
+	heap->rec[0] = heap->rec[--heap->rec_cnt];
+	_job_queue_heap_sift_down(heap, 0);
+	return job_queue_rec;
+}
+
+static void _job_queue_heap_free(job_queue_heap_t *heap)
+{
+	while (heap->rec_cnt)
+		xfree(heap->rec[--heap->rec_cnt]);
+	xfree(heap->rec);
+}
+
 /* Return true if the job has some step still in a cleaning state, which
  * can happen on a Cray if a job is requeued and the step NHC is still running
  * after the requeued job is eligible to run again */
@@ -308,7 +378,7 @@ static bool _job_runnable_test1(struct job_record *job_ptr, bool sched_plugin)
 	if (job_ptr->state_reason == WAIT_FRONT_END) {
 		job_ptr->state_reason = WAIT_NO_REASON;
 		xfree(job_ptr->state_desc);
-		last_job_update = now;
+		set_job_last_update(job_ptr, now);
 	}
 #endif
 
@@ -324,7 +394,7 @@ static bool _job_runnable_test1(struct job_record *job_ptr, bool sched_plugin)
 		    && job_ptr->state_reason != WAIT_MAX_REQUEUE) {
 			job_ptr->state_reason = WAIT_HELD;
 			xfree(job_ptr->state_desc);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 		}
 		sched_debug3("%pJ. State=%s. Reason=%s. Priority=%u.",
 			     job_ptr,
@@ -531,7 +601,7 @@ extern List build_job_queue(bool clear_start, bool backfill)
 			    (job_ptr->state_reason != WAIT_RESOURCES))
 				job_ptr->state_reason_prev_db =
 					job_ptr->state_reason;
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 		} else if ((job_ptr->state_reason_prev == WAIT_TIME) &&
 			   job_ptr->details &&
 			   (job_ptr->details->begin_time <= now)) {
@@ -540,7 +610,7 @@ extern List build_job_queue(bool clear_start, bool backfill)
 			    (job_ptr->state_reason != WAIT_RESOURCES))
 				job_ptr->state_reason_prev_db =
 					job_ptr->state_reason;
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 		}
 		if (!_job_runnable_test1(job_ptr, clear_start))
 			continue;
@@ -557,7 +627,7 @@ extern List build_job_queue(bool clear_start, bool backfill)
 				    (reason != job_ptr->state_reason)) {
 					job_ptr->state_reason = reason;
 					xfree(job_ptr->state_desc);
-					last_job_update = now;
+					set_job_last_update(job_ptr, now);
 				}
 				/* priority_array index matches part_ptr_list
 				 * position: increment inx */
@@ -889,7 +959,7 @@ extern bool deadline_ok(struct job_record *job_ptr, char *func)
 		}
 	}
 	if (fail_job) {
-		last_job_update = now;
+		set_job_last_update(job_ptr, now);
 		job_ptr->job_state = JOB_DEADLINE;
 		job_ptr->exit_code = 1;
 		job_ptr->state_reason = FAIL_DEADLINE;
@@ -907,6 +977,7 @@ static int _schedule(uint32_t job_limit)
 {
 	ListIterator job_iterator = NULL, part_iterator = NULL;
 	List job_queue = NULL;
+	job_queue_heap_t job_heap = { NULL, 0 };
 	int failed_part_cnt = 0, failed_resv_cnt = 0, job_cnt = 0;
 	int error_code, i, j, part_cnt, time_limit, pend_time;
 	uint32_t job_depth = 0, array_task_id;
@@ -940,6 +1011,7 @@ static int _schedule(uint32_t job_limit)
 	bool fail_by_part;
 	uint32_t deadline_time_limit, save_time_limit = 0;
 	uint32_t prio_reserve;
+	struct timeval select_tv;
 #if HAVE_SYS_PRCTL_H
 	char get_name[16];
 #endif
@@ -1191,8 +1263,8 @@ static int _schedule(uint32_t job_limit)
 
 			part_iterator = list_iterator_create(part_list);
 			while ((part_ptr = list_next(part_iterator))) {
-				if (bit_overlap(eff_cg_bitmap,
-						part_ptr->node_bitmap)) {
+				if (bit_overlap_any(eff_cg_bitmap,
+						    part_ptr->node_bitmap)) {
 					failed_parts[failed_part_cnt++] =
 						part_ptr;
 					bit_and_not(avail_node_bitmap,
@@ -1247,7 +1319,8 @@ static int _schedule(uint32_t job_limit)
 	} else {
 		job_queue = build_job_queue(false, false);
 		slurmctld_diag_stats.schedule_queue_len = list_count(job_queue);
-		sort_job_queue(job_queue);
+		_job_queue_heap_build(&job_heap, job_queue);
+		FREE_NULL_LIST(job_queue);
 	}
 	while (1) {
 		if (fifo_sched) {
@@ -1265,7 +1338,7 @@ static int _schedule(uint32_t job_limit)
 			if (!avail_front_end(job_ptr)) {
 				job_ptr->state_reason = WAIT_FRONT_END;
 				xfree(job_ptr->state_desc);
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 				continue;
 			}
 			if (!_job_runnable_test1(job_ptr, false))
@@ -1294,7 +1367,7 @@ next_part:			part_ptr = (struct part_record *)
 					continue;
 			}
 		} else {
-			job_queue_rec = list_pop(job_queue);
+			job_queue_rec = _job_queue_heap_pop(&job_heap);
 			if (!job_queue_rec)
 				break;
 			array_task_id = job_queue_rec->array_task_id;
@@ -1305,7 +1378,7 @@ next_part:			part_ptr = (struct part_record *)
 			if (!avail_front_end(job_ptr)) {
 				job_ptr->state_reason = WAIT_FRONT_END;
 				xfree(job_ptr->state_desc);
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 				continue;
 			}
 			if ((job_ptr->array_task_id != array_task_id) &&
@@ -1426,7 +1499,7 @@ next_task:
 					     failed_part_cnt)) {
 			job_ptr->state_reason = WAIT_PRIORITY;
 			xfree(job_ptr->state_desc);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			sched_debug("%pJ. State=PENDING. Reason=Priority, Priority=%u. Partition=%s.",
 				    job_ptr, job_ptr->priority,
 				    job_ptr->partition);
@@ -1449,7 +1522,7 @@ next_task:
 				job_ptr->state_reason = WAIT_NO_REASON;
 				xfree(job_ptr->state_desc);
 				job_ptr->assoc_id = assoc_rec.id;
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 			} else {
 				sched_debug("%pJ has invalid association",
 					    job_ptr);
@@ -1473,13 +1546,13 @@ next_task:
 				sched_debug("%pJ has invalid QOS", job_ptr);
 				xfree(job_ptr->state_desc);
 				job_ptr->state_reason = FAIL_QOS;
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 				assoc_mgr_unlock(&locks);
 				continue;
 			} else if (job_ptr->state_reason == FAIL_QOS) {
 				xfree(job_ptr->state_desc);
 				job_ptr->state_reason = WAIT_NO_REASON;
-				last_job_update = now;
+				set_job_last_update(job_ptr, now);
 			}
 			assoc_mgr_unlock(&locks);
 		}
@@ -1538,7 +1611,7 @@ next_task:
 			job_ptr->state_desc = xstrdup("Nodes required for job are "
 					"DOWN, DRAINED or reserved for jobs in "
 					"higher priority partitions");
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			sched_debug3("%pJ. State=%s. Reason=%s. Priority=%u. Partition=%s.",
 				     job_ptr,
 				     job_state_string(job_ptr->job_state),
@@ -1550,7 +1623,7 @@ next_task:
 		    SLURM_SUCCESS) {
 			job_ptr->state_reason = WAIT_LICENSES;
 			xfree(job_ptr->state_desc);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			sched_debug3("%pJ. State=%s. Reason=%s. Priority=%u.",
 				     job_ptr,
 				     job_state_string(job_ptr->job_state),
@@ -1567,7 +1640,7 @@ next_task:
 			 * the time we consider running it. It should be
 			 * very rare. */
 			sched_info("%pJ has invalid account", job_ptr);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			job_ptr->state_reason = FAIL_ACCOUNT;
 			xfree(job_ptr->state_desc);
 			continue;
@@ -1586,10 +1659,16 @@ next_task:
 			goto skip_start;
 		}
 
+		memset(&select_tv, 0, sizeof(select_tv));
+		(void) slurm_delta_tv(&select_tv);
 		error_code = select_nodes(job_ptr, false, NULL, NULL, false,
 					  SLURMDB_JOB_FLAG_SCHED);
+		job_ptr->part_ptr->sched_test_time +=
+			slurm_delta_tv(&select_tv);
+		job_ptr->part_ptr->sched_test_cnt++;
 
 		if (error_code == SLURM_SUCCESS) {
+			job_ptr->part_ptr->sched_start_cnt++;
 			/*
 			 * If the following fails because of network
 			 * connectivity, the origin cluster should ask
@@ -1652,7 +1731,7 @@ skip_start:
 		} else if (error_code == ESLURM_FED_JOB_LOCK) {
 			job_ptr->state_reason = WAIT_FED_JOB_LOCK;
 			xfree(job_ptr->state_desc);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			sched_debug3("%pJ. State=%s. Reason=%s. Priority=%u. Partition=%s.",
 				     job_ptr,
 				     job_state_string(job_ptr->job_state),
@@ -1662,7 +1741,7 @@ skip_start:
 		} else if (error_code == SLURM_SUCCESS) {
 			/* job initiated */
 			sched_debug3("%pJ initiated", job_ptr);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			reject_array_job_id = 0;
 			reject_array_part   = NULL;
 
@@ -1710,7 +1789,7 @@ skip_start:
 			   (error_code != ESLURM_INVALID_BURST_BUFFER_REQUEST)){
 			sched_info("schedule: %pJ non-runnable: %s",
 				   job_ptr, slurm_strerror(error_code));
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			job_ptr->job_state = JOB_PENDING;
 			job_ptr->state_reason = FAIL_BAD_CONSTRAINTS;
 			xfree(job_ptr->state_desc);
@@ -1774,6 +1853,7 @@ fail_this_part:	if (fail_by_part) {
 			failed_parts[failed_part_cnt++] = job_ptr->part_ptr;
 			bit_and_not(avail_node_bitmap,
 				job_ptr->part_ptr->node_bitmap);
+			job_ptr->part_ptr->sched_fail_cnt++;
 		}
 
 		if ((reject_array_job_id == job_ptr->array_job_id) &&
@@ -1797,8 +1877,8 @@ fail_this_part:	if (fail_by_part) {
 			list_iterator_destroy(job_iterator);
 		if (part_iterator)
 			list_iterator_destroy(part_iterator);
-	} else if (job_queue) {
-		FREE_NULL_LIST(job_queue);
+	} else {
+		_job_queue_heap_free(&job_heap);
 	}
 	xfree(sched_part_ptr);
 	xfree(sched_part_jobs);
@@ -42,6 +42,8 @@
 #include <string.h>
 #include <sys/types.h>
 
+#include "src/common/pack.h"
+#include "src/common/timers.h"
 #include "src/slurmctld/locks.h"
 #include "src/slurmctld/slurmctld.h"
 
@@ -50,6 +52,26 @@ static pthread_mutex_t state_mutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_rwlock_t slurmctld_locks[ENTITY_COUNT]
 	= { PTHREAD_RWLOCK_INITIALIZER };
 
+/*
+ * Contention statistics for each of the slurmctld locks, reported by sdiag.
+ * A lock request is only counted as having waited if it could not be
+ * granted immediately, in which case the time spent blocked is recorded.
+ */
+typedef struct {
+	uint64_t rd_cnt;	/* read lock requests */
+	uint64_t rd_wait_cnt;	/* read lock requests which blocked */
+	uint64_t rd_wait_time;	/* usec spent blocked on read locks */
+	uint64_t wr_cnt;	/* write lock requests */
+	uint64_t wr_wait_cnt;	/* write lock requests which blocked */
+	uint64_t wr_wait_time;	/* usec spent blocked on write locks */
+} lock_stats_t;
+
+static pthread_mutex_t lock_stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+static lock_stats_t lock_stats[ENTITY_COUNT];
+
+/* Threads currently blocked on each lock, protected by lock_stats_mutex */
+static int lock_waiters[ENTITY_COUNT];
+
 #ifndef NDEBUG
 /*
  * Used to protect against double-locking within a single thread. Calling
@@ -103,35 +125,73 @@ extern bool verify_lock(lock_datatype_t datatype, lock_level_t level)
 }
 #endif
 
+static void _add_waiter(lock_datatype_t datatype)
+{
+	slurm_mutex_lock(&lock_stats_mutex);
+	lock_waiters[datatype]++;
+	slurm_mutex_unlock(&lock_stats_mutex);
+}
+
+/*
+ * _lock_entity - acquire one of the slurmctld locks at the given level,
+ *	recording whether the request had to wait and for how long
+ */
+static void _lock_entity(lock_datatype_t datatype, lock_level_t level)
+{
+	pthread_rwlock_t *lock = &slurmctld_locks[datatype];
+	lock_stats_t *stats = &lock_stats[datatype];
+	bool waited = false;
+	DEF_TIMERS;
+
+	if (level == READ_LOCK) {
+		/* the try functions return zero on success */
+		if (slurm_rwlock_tryrdlock(lock)) {
+			waited = true;
+			_add_waiter(datatype);
+			START_TIMER;
+			slurm_rwlock_rdlock(lock);
+			END_TIMER;
+		}
+	} else if (level == WRITE_LOCK) {
+		if (slurm_rwlock_trywrlock(lock)) {
+			waited = true;
+			_add_waiter(datatype);
+			START_TIMER;
+			slurm_rwlock_wrlock(lock);
+			END_TIMER;
+		}
+	} else
+		return;
+
+	slurm_mutex_lock(&lock_stats_mutex);
+	if (waited)
+		lock_waiters[datatype]--;
+	if (level == READ_LOCK) {
+		stats->rd_cnt++;
+		if (waited) {
+			stats->rd_wait_cnt++;
+			stats->rd_wait_time += DELTA_TIMER;
+		}
+	} else {
+		stats->wr_cnt++;
+		if (waited) {
+			stats->wr_wait_cnt++;
+			stats->wr_wait_time += DELTA_TIMER;
+		}
+	}
+	slurm_mutex_unlock(&lock_stats_mutex);
+}
+
 /* lock_slurmctld - Issue the required lock requests in a well defined order */
 extern void lock_slurmctld(slurmctld_lock_t lock_levels)
 {
 	xassert(_store_locks(lock_levels));
 
-	if (lock_levels.conf == READ_LOCK)
-		slurm_rwlock_rdlock(&slurmctld_locks[CONF_LOCK]);
-	else if (lock_levels.conf == WRITE_LOCK)
-		slurm_rwlock_wrlock(&slurmctld_locks[CONF_LOCK]);
-
-	if (lock_levels.job == READ_LOCK)
-		slurm_rwlock_rdlock(&slurmctld_locks[JOB_LOCK]);
-	else if (lock_levels.job == WRITE_LOCK)
-		slurm_rwlock_wrlock(&slurmctld_locks[JOB_LOCK]);
-
-	if (lock_levels.node == READ_LOCK)
-		slurm_rwlock_rdlock(&slurmctld_locks[NODE_LOCK]);
-	else if (lock_levels.node == WRITE_LOCK)
-		slurm_rwlock_wrlock(&slurmctld_locks[NODE_LOCK]);
-
-	if (lock_levels.part == READ_LOCK)
-		slurm_rwlock_rdlock(&slurmctld_locks[PART_LOCK]);
-	else if (lock_levels.part == WRITE_LOCK)
-		slurm_rwlock_wrlock(&slurmctld_locks[PART_LOCK]);
-
-	if (lock_levels.fed == READ_LOCK)
-		slurm_rwlock_rdlock(&slurmctld_locks[FED_LOCK]);
-	else if (lock_levels.fed == WRITE_LOCK)
-		slurm_rwlock_wrlock(&slurmctld_locks[FED_LOCK]);
+	_lock_entity(CONF_LOCK, lock_levels.conf);
+	_lock_entity(JOB_LOCK,  lock_levels.job);
+	_lock_entity(NODE_LOCK, lock_levels.node);
+	_lock_entity(PART_LOCK, lock_levels.part);
+	_lock_entity(FED_LOCK,  lock_levels.fed);
 }
 
 /* unlock_slurmctld - Issue the required unlock requests in a well
@@ -199,6 +259,63 @@ int report_locks_set(void)
 	return lock_count;
 }
 
+/*
+ * lock_slurmctld_contended - report whether any thread is currently blocked
+ *	waiting for one of the locks held at the given levels
+ */
+extern bool lock_slurmctld_contended(slurmctld_lock_t lock_levels)
+{
+	lock_level_t *levels = (lock_level_t *) &lock_levels;
+	bool contended = false;
+	int i;
+
+	slurm_mutex_lock(&lock_stats_mutex);
+	for (i = 0; i < ENTITY_COUNT; i++) {
+		if ((levels[i] != NO_LOCK) && lock_waiters[i]) {
+			contended = true;
+			break;
+		}
+	}
+	slurm_mutex_unlock(&lock_stats_mutex);
+
+	return contended;
+}
+
+/* pack_lock_stats - pack slurmctld lock contention statistics for sdiag */
+extern void pack_lock_stats(Buf buffer)
+{
+	uint64_t rd_cnt[ENTITY_COUNT], rd_wait_cnt[ENTITY_COUNT];
+	uint64_t rd_wait_time[ENTITY_COUNT], wr_cnt[ENTITY_COUNT];
+	uint64_t wr_wait_cnt[ENTITY_COUNT], wr_wait_time[ENTITY_COUNT];
+	int i;
+
+	slurm_mutex_lock(&lock_stats_mutex);
+	for (i = 0; i < ENTITY_COUNT; i++) {
+		rd_cnt[i]       = lock_stats[i].rd_cnt;
+		rd_wait_cnt[i]  = lock_stats[i].rd_wait_cnt;
+		rd_wait_time[i] = lock_stats[i].rd_wait_time;
+		wr_cnt[i]       = lock_stats[i].wr_cnt;
+		wr_wait_cnt[i]  = lock_stats[i].wr_wait_cnt;
+		wr_wait_time[i] = lock_stats[i].wr_wait_time;
+	}
+	slurm_mutex_unlock(&lock_stats_mutex);
+
+	pack32(ENTITY_COUNT, buffer);
+	pack64_array(rd_cnt,       ENTITY_COUNT, buffer);
+	pack64_array(rd_wait_cnt,  ENTITY_COUNT, buffer);
+	pack64_array(rd_wait_time, ENTITY_COUNT, buffer);
+	pack64_array(wr_cnt,       ENTITY_COUNT, buffer);
+	pack64_array(wr_wait_cnt,  ENTITY_COUNT, buffer);
+	pack64_array(wr_wait_time, ENTITY_COUNT, buffer);
+}
+
+/* reset_lock_stats - clear slurmctld lock contention statistics */
+extern void reset_lock_stats(void)
+{
+	slurm_mutex_lock(&lock_stats_mutex);
+	memset(lock_stats, 0, sizeof(lock_stats));
+	slurm_mutex_unlock(&lock_stats_mutex);
+}
 
 /* un/lock semaphore used for saving state of slurmctld */
 extern void lock_state_files(void)
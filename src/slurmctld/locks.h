@@ -93,6 +93,8 @@
 
 #include <stdbool.h>
 
+#include "src/common/pack.h"
+
 /* levels of locking required for each data structure */
 typedef enum {
 	NO_LOCK,
@@ -135,6 +137,18 @@ extern void unlock_slurmctld (slurmctld_lock_t lock_levels);
 
 extern int report_locks_set(void);
 
+/*
+ * lock_slurmctld_contended - report whether any thread is currently blocked
+ *	waiting for one of the locks held at the given levels
+ */
+extern bool lock_slurmctld_contended(slurmctld_lock_t lock_levels);
+
+/* pack_lock_stats - pack slurmctld lock contention statistics for sdiag */
+extern void pack_lock_stats(Buf buffer);
+
+/* reset_lock_stats - clear slurmctld lock contention statistics */
+extern void reset_lock_stats(void);
+
 /* un/lock semaphore used for saving state of slurmctld */
 extern void lock_state_files ( void );
 extern void unlock_state_files ( void );
@@ -114,6 +114,9 @@ static void 	_make_node_down(struct node_record *node_ptr,
 				time_t event_time);
 static bool	_node_is_hidden(struct node_record *node_ptr, uid_t uid);
 static Buf	_open_node_state_file(char **state_file);
+static void	_pack_listed_node(struct node_record *node_ptr, Buf buffer,
+				  uint16_t protocol_version,
+				  uint16_t show_flags, uid_t uid);
 static void 	_pack_node(struct node_record *dump_node_ptr, Buf buffer,
 			   uint16_t protocol_version, uint16_t show_flags);
 static void	_sync_bitmaps(struct node_record *node_ptr, int job_count);
@@ -772,7 +775,6 @@ extern void pack_all_node (char **buffer_ptr, int *buffer_size,
 	Buf buffer;
 	time_t now = time(NULL);
 	struct node_record *node_ptr = node_record_table_ptr;
-	bool hidden;
 
 	xassert(verify_lock(CONF_LOCK, READ_LOCK));
 	xassert(verify_lock(PART_LOCK, READ_LOCK));
@@ -790,37 +792,8 @@ extern void pack_all_node (char **buffer_ptr, int *buffer_size,
 
 		/* write node records */
 		for (inx = 0; inx < node_record_count; inx++, node_ptr++) {
-			xassert(node_ptr->magic == NODE_MAGIC);
-			xassert(node_ptr->config_ptr->magic == CONFIG_MAGIC);
-
-			/*
-			 * We can't avoid packing node records without breaking
-			 * the node index pointers. So pack a node with a name
-			 * of NULL and let the caller deal with it.
-			 */
-			hidden = false;
-			if (((show_flags & SHOW_ALL) == 0) && (uid != 0) &&
-			    (_node_is_hidden(node_ptr, uid)))
-				hidden = true;
-			else if (IS_NODE_FUTURE(node_ptr) &&
-				 (!(show_flags & SHOW_FUTURE)))
-				hidden = true;
-			else if (_is_cloud_hidden(node_ptr))
-				hidden = true;
-			else if ((node_ptr->name == NULL) ||
-				 (node_ptr->name[0] == '\0'))
-				hidden = true;
-
-			if (hidden) {
-				char *orig_name = node_ptr->name;
-				node_ptr->name = NULL;
-				_pack_node(node_ptr, buffer, protocol_version,
-				           show_flags);
-				node_ptr->name = orig_name;
-			} else {
-				_pack_node(node_ptr, buffer, protocol_version,
-					   show_flags);
-			}
+			_pack_listed_node(node_ptr, buffer, protocol_version,
+					  show_flags, uid);
 			nodes_packed++;
 		}
 	} else if (protocol_version >= SLURM_MIN_PROTOCOL_VERSION) {
@@ -831,37 +804,8 @@ extern void pack_all_node (char **buffer_ptr, int *buffer_size,
 
 		/* write node records */
 		for (inx = 0; inx < node_record_count; inx++, node_ptr++) {
-			xassert (node_ptr->magic == NODE_MAGIC);
-			xassert (node_ptr->config_ptr->magic ==
-				 CONFIG_MAGIC);
-
-			/* We can't avoid packing node records without breaking
-			 * the node index pointers. So pack a node
-			 * with a name of NULL and let the caller deal
-			 * with it. */
-			hidden = false;
-			if (((show_flags & SHOW_ALL) == 0) && (uid != 0) &&
-			    (_node_is_hidden(node_ptr, uid)))
-				hidden = true;
-			else if (IS_NODE_FUTURE(node_ptr) &&
-				 ((show_flags & SHOW_FUTURE) == 0))
-				hidden = true;
-			else if (_is_cloud_hidden(node_ptr))
-				hidden = true;
-			else if ((node_ptr->name == NULL) ||
-				 (node_ptr->name[0] == '\0'))
-				hidden = true;
-
-			if (hidden) {
-				char *orig_name = node_ptr->name;
-				node_ptr->name = NULL;
-				_pack_node(node_ptr, buffer, protocol_version,
-				           show_flags);
-				node_ptr->name = orig_name;
-			} else {
-				_pack_node(node_ptr, buffer, protocol_version,
-					   show_flags);
-			}
+			_pack_listed_node(node_ptr, buffer, protocol_version,
+					  show_flags, uid);
 			nodes_packed++;
 		}
 	} else {
@@ -878,6 +822,119 @@ extern void pack_all_node (char **buffer_ptr, int *buffer_size,
 	buffer_ptr[0] = xfer_buf_data (buffer);
 }
 
+/*
+ * Pack a node record as part of the full node table. We can't avoid packing
+ * node records without breaking the node index pointers, so a hidden node is
+ * packed with a name of NULL and the caller is left to deal with it.
+ */
+static void _pack_listed_node(struct node_record *node_ptr, Buf buffer,
+			      uint16_t protocol_version, uint16_t show_flags,
+			      uid_t uid)
+{
+	bool hidden = false;
+
+	xassert(node_ptr->magic == NODE_MAGIC);
+	xassert(node_ptr->config_ptr->magic == CONFIG_MAGIC);
+
+	if (((show_flags & SHOW_ALL) == 0) && (uid != 0) &&
+	    (_node_is_hidden(node_ptr, uid)))
+		hidden = true;
+	else if (IS_NODE_FUTURE(node_ptr) &&
+		 (!(show_flags & SHOW_FUTURE)))
+		hidden = true;
+	else if (_is_cloud_hidden(node_ptr))
+		hidden = true;
+	else if ((node_ptr->name == NULL) ||
+		 (node_ptr->name[0] == '\0'))
+		hidden = true;
+
+	if (hidden) {
+		char *orig_name = node_ptr->name;
+		node_ptr->name = NULL;
+		_pack_node(node_ptr, buffer, protocol_version, show_flags);
+		node_ptr->name = orig_name;
+	} else {
+		_pack_node(node_ptr, buffer, protocol_version, show_flags);
+	}
+}
+
+/*
+ * pack_delta_node - dump configuration and node information for nodes
+ *	changed since update_time in machine independent form
+ * OUT buffer_ptr - pointer to the stored data
+ * OUT buffer_size - set to size of the buffer in bytes
+ * IN update_time - time of the client's prior response
+ * IN show_flags - node filtering options
+ * IN uid - uid of user making request (for partition filtering)
+ * IN protocol_version - slurm protocol version of client
+ * RET SLURM_SUCCESS or SLURM_ERROR if no delta can be built, in which case
+ *	pack_all_node() must be used
+ * global: node_record_table_ptr - pointer to global node table
+ * NOTE: the caller must xfree the buffer at *buffer_ptr
+ * NOTE: change slurm_load_node_delta() in api/node_info.c when data format
+ *	changes
+ */
+extern int pack_delta_node(char **buffer_ptr, int *buffer_size,
+			   time_t update_time, uint16_t show_flags, uid_t uid,
+			   uint16_t protocol_version)
+{
+	int inx;
+	uint32_t nodes_packed = 0, tmp_offset, *node_inx;
+	Buf buffer;
+	time_t now = time(NULL);
+	struct node_record *node_ptr = node_record_table_ptr;
+
+	xassert(verify_lock(CONF_LOCK, READ_LOCK));
+	xassert(verify_lock(NODE_LOCK, READ_LOCK));
+	xassert(verify_lock(PART_LOCK, READ_LOCK));
+
+	buffer_ptr[0] = NULL;
+	*buffer_size = 0;
+
+	if (protocol_version < SLURM_19_05_PROTOCOL_VERSION)
+		return SLURM_ERROR;
+
+	/*
+	 * Changes made in the second of update_time may precede or follow
+	 * the client's prior response, so treat them as later changes.
+	 * Partition and configuration changes can alter the visibility of
+	 * any node or rebuild the node table, so those always require a full
+	 * response.
+	 */
+	if ((update_time <= slurmctld_config.boot_time) ||
+	    (update_time <= last_part_update) ||
+	    (update_time <= slurmctld_conf.last_update))
+		return SLURM_ERROR;
+
+	buffer = init_buf(BUF_SIZE);
+	node_inx = xmalloc(sizeof(uint32_t) * (node_record_count + 1));
+
+	/* write header: count and time */
+	pack32(nodes_packed, buffer);
+	pack_time(now, buffer);
+
+	/* write changed node records, followed by their table indexes */
+	for (inx = 0; inx < node_record_count; inx++, node_ptr++) {
+		if (node_ptr->last_update < update_time)
+			continue;
+		_pack_listed_node(node_ptr, buffer, protocol_version,
+				  show_flags, uid);
+		node_inx[nodes_packed++] = inx;
+	}
+	pack32_array(node_inx, nodes_packed, buffer);
+	xfree(node_inx);
+
+	tmp_offset = get_buf_offset(buffer);
+	set_buf_offset(buffer, 0);
+	pack32(nodes_packed, buffer);
+	set_buf_offset(buffer, tmp_offset);
+
+	*buffer_size = get_buf_offset(buffer);
+	buffer_ptr[0] = xfer_buf_data(buffer);
+
+	return SLURM_SUCCESS;
+}
+
 /*
  * pack_one_node - dump all configuration and node information for one node
  *	in machine independent form (for network transmission)
@@ -1291,6 +1348,8 @@ int update_node ( update_node_msg_t * update_node_msg )
 			free (this_node_name);
 			break;
 		}
+		/* also covers the feature, gres and weight updates below */
+		set_node_last_update(node_ptr, now);
 
 		if (hostaddr_list) {
 			char *this_addr = hostlist_shift(hostaddr_list);
@@ -2197,6 +2256,7 @@ extern int drain_nodes(char *nodes, char *reason, uint32_t reason_uid)
 		}
 
 		select_g_update_node_state(node_ptr);
+		set_node_last_update(node_ptr, now);
 
 		free (this_node_name);
 	}
@@ -2646,12 +2706,12 @@ extern int validate_node_specs(slurm_node_registration_status_msg_t *reg_msg,
 	if (node_ptr->cpu_load != reg_msg->cpu_load) {
 		node_ptr->cpu_load = reg_msg->cpu_load;
 		node_ptr->cpu_load_time = now;
-		last_node_update = now;
+		set_node_last_update(node_ptr, now);
 	}
 	if (node_ptr->free_mem != reg_msg->free_mem) {
 		node_ptr->free_mem = reg_msg->free_mem;
 		node_ptr->free_mem_time = now;
-		last_node_update = now;
+		set_node_last_update(node_ptr, now);
 	}
 
 	if (IS_NODE_NO_RESPOND(node_ptr) ||
@@ -2676,7 +2736,7 @@ extern int validate_node_specs(slurm_node_registration_status_msg_t *reg_msg,
 
 		bit_clear(power_node_bitmap, node_inx);
 
-		last_node_update = now;
+		set_node_last_update(node_ptr, now);
 	}
 
 	node_flags = node_ptr->node_state & NODE_STATE_FLAGS;
@@ -2697,7 +2757,7 @@ extern int validate_node_specs(slurm_node_registration_status_msg_t *reg_msg,
 						reason_down,
 						slurmctld_conf.slurm_user_id);
 		}
-		last_node_update = time (NULL);
+		set_node_last_update(node_ptr, time(NULL));
 	} else if (reg_msg->status == ESLURMD_PROLOG_FAILED
 		   || reg_msg->status == ESLURMD_SETUP_ENVIRONMENT_ERROR) {
 		if (!IS_NODE_DRAIN(node_ptr) && !IS_NODE_FAIL(node_ptr)) {
@@ -2711,7 +2771,7 @@ extern int validate_node_specs(slurm_node_registration_status_msg_t *reg_msg,
 				reason = "Job env setup error";
 			drain_nodes(reg_msg->node_name, reason,
 				    slurmctld_conf.slurm_user_id);
-			last_node_update = time (NULL);
+			set_node_last_update(node_ptr, time(NULL));
 		}
 	} else {
 		if (IS_NODE_UNKNOWN(node_ptr) || IS_NODE_FUTURE(node_ptr)) {
@@ -2737,7 +2797,7 @@ extern int validate_node_specs(slurm_node_registration_status_msg_t *reg_msg,
 					node_flags;
 				node_ptr->last_idle = now;
 			}
-			last_node_update = now;
+			set_node_last_update(node_ptr, now);
 
 			/* don't send this on a slurmctld unless needed */
 			if (unknown && slurmctld_init_db
@@ -2789,7 +2849,7 @@ extern int validate_node_specs(slurm_node_registration_status_msg_t *reg_msg,
 			info("node %s returned to service",
 			     reg_msg->node_name);
 			trigger_node_up(node_ptr);
-			last_node_update = now;
+			set_node_last_update(node_ptr, now);
 			if (!IS_NODE_DRAIN(node_ptr)
 			    && !IS_NODE_DOWN(node_ptr)
 			    && !IS_NODE_FAIL(node_ptr)) {
@@ -2818,17 +2878,17 @@ extern int validate_node_specs(slurm_node_registration_status_msg_t *reg_msg,
 			     (uint32_t)node_ptr->last_response);
 			_make_node_down(node_ptr, now);
 			kill_running_job_by_node_name(reg_msg->node_name);
-			last_node_update = now;
+			set_node_last_update(node_ptr, now);
 			reg_msg->job_count = 0;
 		} else if (IS_NODE_ALLOCATED(node_ptr) &&
 			   (reg_msg->job_count == 0)) {	/* job vanished */
 			node_ptr->node_state = NODE_STATE_IDLE | node_flags;
 			node_ptr->last_idle = now;
-			last_node_update = now;
+			set_node_last_update(node_ptr, now);
 		} else if (IS_NODE_COMPLETING(node_ptr) &&
 			   (reg_msg->job_count == 0)) {	/* job already done */
 			node_ptr->node_state &= (~NODE_STATE_COMPLETING);
-			last_node_update = now;
+			set_node_last_update(node_ptr, now);
 			bit_clear(cg_node_bitmap, node_inx);
 		} else if (IS_NODE_IDLE(node_ptr) &&
 			   (reg_msg->job_count != 0)) {
@@ -2848,7 +2908,7 @@ extern int validate_node_specs(slurm_node_registration_status_msg_t *reg_msg,
 				node_ptr->node_state |= NODE_STATE_COMPLETING;
 				bit_set(cg_node_bitmap, node_inx);
 			}
-			last_node_update = now;
+			set_node_last_update(node_ptr, now);
 		}
 		if (IS_NODE_IDLE(node_ptr)) {
 			node_ptr->owner = NO_VAL;
@@ -3116,7 +3176,7 @@ extern int validate_nodes_via_front_end(
 				      node_ptr->name);
 			}
 			set_node_down(node_ptr->name, reason_down);
-			last_node_update = now;
+			set_node_last_update(node_ptr, now);
 		}
 		xfree(reason_down);
 		gres_plugin_node_state_log(node_ptr->gres_list, node_ptr->name);
@@ -3129,6 +3189,7 @@ extern int validate_nodes_via_front_end(
 
 		if (IS_NODE_NO_RESPOND(node_ptr)) {
 			update_node_state = true;
+			set_node_last_update(node_ptr, now);
 			/* This is handled by the select/cray plugin */
 			node_ptr->node_state &= (~NODE_STATE_NO_RESPOND);
 			node_ptr->node_state &= (~NODE_STATE_POWER_UP);
@@ -3144,6 +3205,7 @@ extern int validate_nodes_via_front_end(
 			node_flags = node_ptr->node_state & NODE_STATE_FLAGS;
 			if (IS_NODE_UNKNOWN(node_ptr)) {
 				update_node_state = true;
+				set_node_last_update(node_ptr, now);
 				*newly_up = true;
 				if (node_ptr->run_job_cnt) {
 					node_ptr->node_state =
@@ -3171,6 +3233,7 @@ extern int validate_nodes_via_front_end(
 				     !xstrcmp(node_ptr->reason,
 					      "Not responding")))) {
 				update_node_state = true;
+				set_node_last_update(node_ptr, now);
 				*newly_up = true;
 				if (node_ptr->run_job_cnt) {
 					node_ptr->node_state =
@@ -3196,6 +3259,7 @@ extern int validate_nodes_via_front_end(
 				   (node_ptr->run_job_cnt == 0)) {
 				/* job vanished */
 				update_node_state = true;
+				set_node_last_update(node_ptr, now);
 				node_ptr->node_state = NODE_STATE_IDLE |
 					node_flags;
 				node_ptr->last_idle = now;
@@ -3203,12 +3267,14 @@ extern int validate_nodes_via_front_end(
 				   (node_ptr->comp_job_cnt == 0)) {
 				/* job already done */
 				update_node_state = true;
+				set_node_last_update(node_ptr, now);
 				node_ptr->node_state &=
 					(~NODE_STATE_COMPLETING);
 				bit_clear(cg_node_bitmap, i);
 			} else if (IS_NODE_IDLE(node_ptr) &&
 				   (node_ptr->run_job_cnt != 0)) {
 				update_node_state = true;
+				set_node_last_update(node_ptr, now);
 				node_ptr->node_state = NODE_STATE_ALLOCATED |
 						       node_flags;
 				error("Invalid state for node %s, was IDLE "
@@ -3336,7 +3402,7 @@ static void _node_did_resp(struct node_record *node_ptr)
 		node_ptr->node_state &= (~NODE_STATE_REBOOT);
 		if (!is_node_in_maint_reservation(node_inx))
 			node_ptr->node_state &= (~NODE_STATE_MAINT);
-		last_node_update = now;
+		set_node_last_update(node_ptr, now);
 	}
 	node_flags = node_ptr->node_state & NODE_STATE_FLAGS;
 	if (IS_NODE_UNKNOWN(node_ptr)) {
@@ -3346,7 +3412,7 @@ static void _node_did_resp(struct node_record *node_ptr)
 					       node_flags;
 		} else
 			node_ptr->node_state = NODE_STATE_IDLE | node_flags;
-		last_node_update = now;
+		set_node_last_update(node_ptr, now);
 		if (!IS_NODE_DRAIN(node_ptr) && !IS_NODE_FAIL(node_ptr)) {
 			clusteracct_storage_g_node_up(acct_db_conn,
 						      node_ptr, now);
@@ -3362,7 +3428,7 @@ static void _node_did_resp(struct node_record *node_ptr)
 		info("node_did_resp: node %s returned to service",
 		     node_ptr->name);
 		trigger_node_up(node_ptr);
-		last_node_update = now;
+		set_node_last_update(node_ptr, now);
 		if (!IS_NODE_DRAIN(node_ptr) && !IS_NODE_FAIL(node_ptr)) {
 			/* reason information is handled in
 			   clusteracct_storage_g_node_up()
@@ -3468,7 +3534,7 @@ void node_not_resp (char *name, time_t msg_time, slurm_msg_type_t resp_type)
 #ifdef HAVE_FRONT_END
 		last_front_end_update = time(NULL);
 #else
-		last_node_update = time(NULL);
+		set_node_last_update(node_ptr, time(NULL));
 		bit_clear (avail_node_bitmap, (node_ptr - node_record_table_ptr));
 #endif
 	}
@@ -3527,6 +3593,19 @@ void set_node_down (char *name, char *reason)
 	return;
 }
 
+/*
+ * set_node_last_update - note a change to a node's information, used to
+ *	build node info deltas
+ * IN node_ptr - pointer to the node_record
+ * IN now - time of the change
+ * global: last_node_update - time of last node table update
+ */
+extern void set_node_last_update(struct node_record *node_ptr, time_t now)
+{
+	node_ptr->last_update = now;
+	last_node_update = now;
+}
+
 /*
  * set_node_down_ptr - make the specified compute node's state DOWN and
  *	kill jobs as needed
@@ -3718,7 +3797,7 @@ extern void make_node_alloc(struct node_record *node_ptr,
 	node_ptr->reason_time = 0;
 	node_ptr->reason_uid = NO_VAL;
 
-	last_node_update = time(NULL);
+	set_node_last_update(node_ptr, time(NULL));
 }
 
 /* make_node_avail - flag specified node as available */
@@ -3801,7 +3880,7 @@ extern void make_node_comp(struct node_record *node_ptr,
 		node_ptr->node_state = NODE_STATE_IDLE | node_flags;
 		node_ptr->last_idle = now;
 	}
-	last_node_update = now;
+	set_node_last_update(node_ptr, now);
 }
 
 /* _make_node_down - flag specified node as down */
@@ -3823,7 +3902,7 @@ static void _make_node_down(struct node_record *node_ptr, time_t event_time)
 	bit_clear (up_node_bitmap,    inx);
 	select_g_update_node_state(node_ptr);
 	trigger_node_down(node_ptr);
-	last_node_update = time (NULL);
+	set_node_last_update(node_ptr, time(NULL));
 	clusteracct_storage_g_node_down(acct_db_conn,
 					node_ptr, event_time, NULL,
 					node_ptr->reason_uid);
@@ -3854,7 +3933,7 @@ void make_node_idle(struct node_record *node_ptr,
 	xassert(node_ptr);
 	if (node_bitmap && (bit_test(node_bitmap, inx))) {
 		/* Not a replay */
-		last_job_update = now;
+		set_job_last_update(job_ptr, now);
 		bit_clear(node_bitmap, inx);
 
 		job_update_tres_cnt(job_ptr, inx);
@@ -3971,7 +4050,7 @@ fini:
 			xfree(node_ptr->mcs_label);
 		}
 	}
-	last_node_update = now;
+	set_node_last_update(node_ptr, now);
 }
 
 extern int send_nodes_to_accounting(time_t event_time)
@@ -4038,7 +4117,7 @@ extern void reset_node_load(char *node_name, uint32_t cpu_load)
 		time_t now = time(NULL);
 		node_ptr->cpu_load = cpu_load;
 		node_ptr->cpu_load_time = now;
-		last_node_update = now;
+		set_node_last_update(node_ptr, now);
 	} else
 		error("reset_node_load unable to find node %s", node_name);
 #endif
@@ -4057,7 +4136,7 @@ extern void reset_node_free_mem(char *node_name, uint64_t free_mem)
 		time_t now = time(NULL);
 		node_ptr->free_mem = free_mem;
 		node_ptr->free_mem_time = now;
-		last_node_update = now;
+		set_node_last_update(node_ptr, now);
 	} else
 		error("reset_node_free_mem unable to find node %s", node_name);
 #endif
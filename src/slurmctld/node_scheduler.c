@@ -1234,8 +1234,8 @@ _get_req_features(struct node_set *node_set_ptr, int node_set_size,
 			 * purge it
 			 */
 			for (i = 0; i < node_set_size; i++) {
-				if (!bit_overlap(node_set_ptr[i].my_bitmap,
-						 work_bitmap))
+				if (!bit_overlap_any(node_set_ptr[i].my_bitmap,
+						     work_bitmap))
 					continue;
 				tmp_node_set_ptr[tmp_node_set_size].
 					cpus_per_node =
@@ -1959,10 +1959,9 @@ _pick_best_nodes(struct node_set *node_set_ptr, int node_set_size,
 				/* Node reboot required */
 				count1 = bit_set_count(node_set_ptr[i].
 						       my_bitmap);
-				bit_and(node_set_ptr[i].my_bitmap,
+				count2 = bit_and_set_count(
+					node_set_ptr[i].my_bitmap,
 					idle_node_bitmap);
-				count2 = bit_set_count(node_set_ptr[i].
-						       my_bitmap);
 				if (count1 != count2)
 					nodes_busy = true;
 			}
@@ -2264,12 +2263,12 @@ _pick_best_nodes(struct node_set *node_set_ptr, int node_set_size,
 					   share_node_bitmap)) {
 				error_code = ESLURM_NODES_BUSY;
 			}
-			if (bit_overlap(job_ptr->details->req_node_bitmap,
-					cg_node_bitmap)) {
+			if (bit_overlap_any(job_ptr->details->req_node_bitmap,
+					    cg_node_bitmap)) {
 				error_code = ESLURM_NODES_BUSY;
 			}
-			if (bit_overlap(job_ptr->details->req_node_bitmap,
-					rs_node_bitmap)) {
+			if (bit_overlap_any(job_ptr->details->req_node_bitmap,
+					    rs_node_bitmap)) {
 				error_code = ESLURM_NODES_BUSY;
 			}
 		} else if (!bit_super_set(job_ptr->details->req_node_bitmap,
@@ -2278,10 +2277,10 @@ _pick_best_nodes(struct node_set *node_set_ptr, int node_set_size,
 			/* Note: IDLE nodes are not COMPLETING */
 		}
 	} else if (job_ptr->details->req_node_bitmap &&
-		   (bit_overlap(job_ptr->details->req_node_bitmap,
-			       cg_node_bitmap) ||
-		    bit_overlap(job_ptr->details->req_node_bitmap,
-			       rs_node_bitmap))) {
+		   (bit_overlap_any(job_ptr->details->req_node_bitmap,
+				    cg_node_bitmap) ||
+		    bit_overlap_any(job_ptr->details->req_node_bitmap,
+				    rs_node_bitmap))) {
 		error_code = ESLURM_NODES_BUSY;
 	}
 
@@ -2590,7 +2589,7 @@ extern int select_nodes(struct job_record *job_ptr, bool test_only,
 		    (job_ptr->state_reason == FAIL_BURST_BUFFER_OP))
 			return ESLURM_BURST_BUFFER_WAIT; /* Fatal BB event */
 		xfree(job_ptr->state_desc);
-		last_job_update = now;
+		set_job_last_update(job_ptr, now);
 		if (bb == 0)
 			job_ptr->state_reason = WAIT_BURST_BUFFER_STAGING;
 		else
@@ -2738,7 +2737,7 @@ extern int select_nodes(struct job_record *job_ptr, bool test_only,
 			       __func__, job_ptr);
 			job_ptr->state_reason = WAIT_PART_NODE_LIMIT;
 			xfree(job_ptr->state_desc);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 
 		/* Non-fatal errors for job below */
 		} else if (error_code == ESLURM_NODE_NOT_AVAIL) {
@@ -2755,8 +2754,8 @@ extern int select_nodes(struct job_record *job_ptr, bool test_only,
 			bit_and_not(unavail_bitmap, future_node_bitmap);
 			if (job_ptr->details  &&
 			    job_ptr->details->req_node_bitmap &&
-			    bit_overlap(unavail_bitmap,
-					job_ptr->details->req_node_bitmap)) {
+			    bit_overlap_any(unavail_bitmap,
+					    job_ptr->details->req_node_bitmap)) {
 				bit_and(unavail_bitmap,
 					job_ptr->details->req_node_bitmap);
 			}
@@ -2776,7 +2775,7 @@ extern int select_nodes(struct job_record *job_ptr, bool test_only,
 					   "for other job");
 			}
 			xfree(unavail_node);
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 		} else if (error_code == ESLURM_RESERVATION_MAINT) {
 			error_code = ESLURM_RESERVATION_BUSY;	/* All reserved */
 			job_ptr->state_reason = WAIT_NODE_NOT_AVAIL;
@@ -2857,7 +2856,7 @@ extern int select_nodes(struct job_record *job_ptr, bool test_only,
 		job_ptr->end_time = 0;
 		job_ptr->priority = 0;
 		job_ptr->state_reason = WAIT_HELD;
-		last_job_update = now;
+		set_job_last_update(job_ptr, now);
 		goto cleanup;
 	}
 	if (select_g_job_begin(job_ptr) != SLURM_SUCCESS) {
@@ -2872,7 +2871,7 @@ extern int select_nodes(struct job_record *job_ptr, bool test_only,
 		job_ptr->time_last_active = 0;
 		job_ptr->end_time = 0;
 		job_ptr->state_reason = WAIT_RESOURCES;
-		last_job_update = now;
+		set_job_last_update(job_ptr, now);
 		goto cleanup;
 	}
 
@@ -2895,7 +2894,7 @@ extern int select_nodes(struct job_record *job_ptr, bool test_only,
 		job_ptr->time_last_active = 0;
 		job_ptr->end_time = 0;
 		job_ptr->state_reason = WAIT_RESOURCES;
-		last_job_update = now;
+		set_job_last_update(job_ptr, now);
 		goto cleanup;
 	}
 
@@ -2923,7 +2922,7 @@ extern int select_nodes(struct job_record *job_ptr, bool test_only,
 			job_ptr->end_time = 0;
 			job_ptr->state_reason = WAIT_RESOURCES;
 			job_ptr->job_state = JOB_PENDING;
-			last_job_update = now;
+			set_job_last_update(job_ptr, now);
 			goto cleanup;
 		}
 	}
@@ -3781,8 +3780,8 @@ static int _build_node_list(struct job_record *job_ptr,
 			}
 			/* No nodes in set require reboot */
 			if (node_maps[REBOOT] &&
-			    !bit_overlap(prev_node_set_ptr->my_bitmap,
-					 node_maps[REBOOT]))
+			    !bit_overlap_any(prev_node_set_ptr->my_bitmap,
+					     node_maps[REBOOT]))
 				FREE_NULL_BITMAP(node_maps[REBOOT]);
 		}
 
@@ -4580,7 +4579,8 @@ extern void re_kill_job(struct job_record *job_ptr)
 					(node_ptr->comp_job_cnt)--;
 				if ((job_ptr->node_cnt > 0) &&
 				    ((--job_ptr->node_cnt) == 0)) {
-					last_node_update = time(NULL);
+					set_node_last_update(node_ptr,
+							     time(NULL));
 					cleanup_completing(job_ptr);
 					batch_requeue_fini(job_ptr);
 					last_node_update = time(NULL);
@@ -4610,7 +4610,7 @@ extern void re_kill_job(struct job_record *job_ptr)
 			    ((--job_ptr->node_cnt) == 0)) {
 				cleanup_completing(job_ptr);
 				batch_requeue_fini(job_ptr);
-				last_node_update = time(NULL);
+				set_node_last_update(node_ptr, time(NULL));
 			}
 		} else if (!IS_NODE_NO_RESPOND(node_ptr)) {
 			(void)hostlist_push_host(kill_hostlist, node_ptr->name);
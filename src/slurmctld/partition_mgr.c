@@ -2261,7 +2261,7 @@ extern int part_policy_valid_acct(struct part_record *part_ptr, char *acct,
 				xfree(job_ptr->state_desc);
 				job_ptr->state_desc = tmp_err;
 				job_ptr->state_reason = WAIT_ACCOUNT;
-				last_job_update = time(NULL);
+				set_job_last_update(job_ptr, time(NULL));
 			} else {
 				xfree(tmp_err);
 			}
@@ -2285,7 +2285,7 @@ extern int part_policy_valid_acct(struct part_record *part_ptr, char *acct,
 				xfree(job_ptr->state_desc);
 				job_ptr->state_desc = tmp_err;
 				job_ptr->state_reason = WAIT_ACCOUNT;
-				last_job_update = time(NULL);
+				set_job_last_update(job_ptr, time(NULL));
 			} else {
 				xfree(tmp_err);
 			}
@@ -2316,7 +2316,7 @@ extern int part_policy_valid_acct(struct part_record *part_ptr, char *acct,
 				xfree(job_ptr->state_desc);
 				job_ptr->state_desc = tmp_err;
 				job_ptr->state_reason = WAIT_ACCOUNT;
-				last_job_update = time(NULL);
+				set_job_last_update(job_ptr, time(NULL));
 			} else {
 				xfree(tmp_err);
 			}
@@ -2352,7 +2352,7 @@ extern int part_policy_valid_qos(struct part_record *part_ptr,
 				xfree(job_ptr->state_desc);
 				job_ptr->state_desc = tmp_err;
 				job_ptr->state_reason = WAIT_QOS;
-				last_job_update = time(NULL);
+				set_job_last_update(job_ptr, time(NULL));
 			} else {
 				xfree(tmp_err);
 			}
@@ -2371,7 +2371,7 @@ extern int part_policy_valid_qos(struct part_record *part_ptr,
 				xfree(job_ptr->state_desc);
 				job_ptr->state_desc = tmp_err;
 				job_ptr->state_reason = WAIT_QOS;
-				last_job_update = time(NULL);
+				set_job_last_update(job_ptr, time(NULL));
 			} else {
 				xfree(tmp_err);
 			}
@@ -2397,7 +2397,7 @@ extern int part_policy_valid_qos(struct part_record *part_ptr,
 				xfree(job_ptr->state_desc);
 				job_ptr->state_desc = tmp_err;
 				job_ptr->state_reason = WAIT_QOS;
-				last_job_update = time(NULL);
+				set_job_last_update(job_ptr, time(NULL));
 			} else {
 				xfree(tmp_err);
 			}
@@ -373,6 +373,7 @@ static void _do_power_work(time_t now)
 			bit_set(booting_node_bitmap, i);
 			bit_set(resume_node_bitmap,  i);
 			bit_set(wake_node_bitmap,    i);
+			set_node_last_update(node_ptr, now);
 		}
 
 		/* Suspend nodes as appropriate */
@@ -404,6 +405,7 @@ static void _do_power_work(time_t now)
 			bit_set(suspend_node_bitmap, i);
 			last_suspend = now;
 			node_ptr->last_idle = 0;
+			set_node_last_update(node_ptr, now);
 		}
 
 		/*
@@ -426,6 +428,7 @@ static void _do_power_work(time_t now)
 			bit_clear(booting_node_bitmap, i);
 			bit_clear(resume_node_bitmap, i);
 			node_ptr->last_idle = 0;
+			set_node_last_update(node_ptr, now);
 
 			if (resume_fail_prog) {
 				if (!failed_node_bitmap) {
@@ -534,6 +537,7 @@ extern int power_job_reboot(struct job_record *job_ptr)
 		node_ptr->last_response = now + resume_timeout;
 		bit_set(booting_node_bitmap, i);
 		bit_set(resume_node_bitmap,  i);
+		set_node_last_update(node_ptr, now);
 	}
 
 	if (job_ptr->details && job_ptr->details->features &&
@@ -259,8 +259,8 @@ void slurmctld_req(slurm_msg_t *msg, connection_arg_t *arg)
 		fd_set_nonblocking(arg->newsockfd);
 
 #ifndef NDEBUG
-	if ((msg->flags & SLURM_DROP_PRIV))
-		drop_priv = true;
+	/* RPC handling threads are reused, so always reset this flag */
+	drop_priv = (msg->flags & SLURM_DROP_PRIV) ? true : false;
 #endif
 
 	/* Just to validate the cred */
@@ -1761,6 +1761,9 @@ static void _slurm_rpc_dump_jobs(slurm_msg_t * msg)
 	slurm_msg_t response_msg;
 	job_info_request_msg_t *job_info_request_msg =
 		(job_info_request_msg_t *) msg->data;
+	uint16_t msg_type = RESPONSE_JOB_INFO;
+	uint16_t show_flags = job_info_request_msg->show_flags & (~SHOW_DELTA);
+	bool all_jobs = false;
 	/* Locks: Read config job part */
 	slurmctld_lock_t job_read_lock = {
 		READ_LOCK, READ_LOCK, NO_LOCK, READ_LOCK, READ_LOCK };
@@ -1779,12 +1782,19 @@ static void _slurm_rpc_dump_jobs(slurm_msg_t * msg)
 		if (job_info_request_msg->job_ids) {
 			pack_spec_jobs(&dump, &dump_size,
 				       job_info_request_msg->job_ids,
-				       job_info_request_msg->show_flags, uid,
-				       NO_VAL, msg->protocol_version);
+				       show_flags, uid, NO_VAL,
+				       msg->protocol_version);
+		} else if ((job_info_request_msg->show_flags & SHOW_DELTA) &&
+			   (pack_delta_jobs(&dump, &dump_size,
+					    job_info_request_msg->last_update,
+					    show_flags, uid,
+					    msg->protocol_version) ==
+			    SLURM_SUCCESS)) {
+			msg_type = RESPONSE_JOB_INFO_DELTA;
 		} else {
-			pack_all_jobs(&dump, &dump_size,
-				      job_info_request_msg->show_flags, uid,
+			pack_all_jobs(&dump, &dump_size, show_flags, uid,
 				      NO_VAL, msg->protocol_version);
+			all_jobs = true;
 		}
 		unlock_slurmctld(job_read_lock);
 		END_TIMER2("_slurm_rpc_dump_jobs");
@@ -1798,13 +1808,16 @@ static void _slurm_rpc_dump_jobs(slurm_msg_t * msg)
 		response_msg.protocol_version = msg->protocol_version;
 		response_msg.address = msg->address;
 		response_msg.conn = msg->conn;
-		response_msg.msg_type = RESPONSE_JOB_INFO;
+		response_msg.msg_type = msg_type;
 		response_msg.data = dump;
 		response_msg.data_size = dump_size;
 
 		/* send message */
 		slurm_send_node_msg(msg->conn_fd, &response_msg);
-		xfree(dump);
+		if (all_jobs)
+			free_job_info_buf(dump);
+		else
+			xfree(dump);
 	}
 }
 
@@ -1846,7 +1859,7 @@ static void _slurm_rpc_dump_jobs_user(slurm_msg_t * msg)
 
 	/* send message */
 	slurm_send_node_msg(msg->conn_fd, &response_msg);
-	xfree(dump);
+	free_job_info_buf(dump);
 }
 
 /* _slurm_rpc_dump_job_single - process RPC for one job's state information */
@@ -2075,6 +2088,8 @@ static void _slurm_rpc_dump_nodes(slurm_msg_t * msg)
 	slurm_msg_t response_msg;
 	node_info_request_msg_t *node_req_msg =
 		(node_info_request_msg_t *) msg->data;
+	uint16_t msg_type = RESPONSE_NODE_INFO;
+	uint16_t show_flags = node_req_msg->show_flags & (~SHOW_DELTA);
 	/* Locks: Read config, write node (reset allocated CPU count in some
 	 * select plugins), read part (for part_is_visible) */
 	slurmctld_lock_t node_write_lock = {
@@ -2102,8 +2117,15 @@ static void _slurm_rpc_dump_nodes(slurm_msg_t * msg)
 		debug3("_slurm_rpc_dump_nodes, no change");
 		slurm_send_rc_msg(msg, SLURM_NO_CHANGE_IN_DATA);
 	} else {
-		pack_all_node(&dump, &dump_size, node_req_msg->show_flags,
-			      uid, msg->protocol_version);
+		if ((node_req_msg->show_flags & SHOW_DELTA) &&
+		    (pack_delta_node(&dump, &dump_size,
+				     node_req_msg->last_update, show_flags, uid,
+				     msg->protocol_version) == SLURM_SUCCESS)) {
+			msg_type = RESPONSE_NODE_INFO_DELTA;
+		} else {
+			pack_all_node(&dump, &dump_size, show_flags, uid,
+				      msg->protocol_version);
+		}
 		unlock_slurmctld(node_write_lock);
 		END_TIMER2("_slurm_rpc_dump_nodes");
 #if 0
@@ -2116,7 +2138,7 @@ static void _slurm_rpc_dump_nodes(slurm_msg_t * msg)
 		response_msg.protocol_version = msg->protocol_version;
 		response_msg.address = msg->address;
 		response_msg.conn = msg->conn;
-		response_msg.msg_type = RESPONSE_NODE_INFO;
+		response_msg.msg_type = msg_type;
 		response_msg.data = dump;
 		response_msg.data_size = dump_size;
 
@@ -6878,6 +6900,7 @@ static void _slurm_rpc_persist_init(slurm_msg_t *msg, connection_arg_t *arg)
 	//persist_conn->timeout = 0; /* we want this to be 0 */
 
 	persist_conn->version = persist_init->version;
+	slurm_persist_conn_set_lz4(persist_conn, msg->flags);
 	memcpy(&p_tmp, persist_conn, sizeof(slurm_persist_conn_t));
 
 	if (persist_init->persist_type == PERSIST_TYPE_FED)
@@ -6889,7 +6912,10 @@ end_it:
 	/* If people are really hammering the fed_mgr we could get into trouble
 	 * with the persist_conn we sent in, so use the copy instead
 	 */
-	ret_buf = slurm_persist_make_rc_msg(&p_tmp, rc, comment, p_tmp.version);
+	ret_buf = slurm_persist_make_rc_msg_flags(&p_tmp, rc, comment,
+						  p_tmp.flags &
+						  PERSIST_FLAG_LZ4,
+						  p_tmp.version);
 	if (slurm_persist_send_msg(&p_tmp, ret_buf) != SLURM_SUCCESS) {
 		debug("Problem sending response to connection %d uid(%d)",
 		      p_tmp.fd, uid);
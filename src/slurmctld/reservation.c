@@ -2856,7 +2856,8 @@ extern int delete_resv(reservation_name_msg_t *resv_desc_ptr)
 {
 	ListIterator iter;
 	slurmctld_resv_t *resv_ptr;
-	int rc = SLURM_SUCCESS;
+	struct node_record *node_ptr;
+	int i, rc = SLURM_SUCCESS;
 	time_t now = time(NULL);
 
 	if (slurmctld_conf.debug_flags & DEBUG_FLAG_RESERVATION)
@@ -2875,6 +2876,12 @@ extern int delete_resv(reservation_name_msg_t *resv_desc_ptr)
 			resv_ptr->flags_set_node = false;
 			_set_nodes_flags(resv_ptr, now,
 					 (NODE_STATE_RES | NODE_STATE_MAINT));
+			for (i = 0, node_ptr = node_record_table_ptr;
+			     resv_ptr->node_bitmap && (i < node_record_count);
+			     i++, node_ptr++) {
+				if (bit_test(resv_ptr->node_bitmap, i))
+					set_node_last_update(node_ptr, now);
+			}
 			last_node_update = now;
 		}
 
@@ -5604,7 +5611,7 @@ extern int set_node_maint_mode(bool reset_all)
 {
 	int i, res_start_cnt = 0;
 	struct node_record *node_ptr;
-	uint32_t flags;
+	uint32_t flags, *old_state;
 	ListIterator iter;
 	slurmctld_resv_t *resv_ptr;
 	time_t now = time(NULL);
@@ -5615,8 +5622,10 @@ extern int set_node_maint_mode(bool reset_all)
 	flags = NODE_STATE_RES;
 	if (reset_all)
 		flags |= NODE_STATE_MAINT;
+	old_state = xmalloc(sizeof(uint32_t) * (node_record_count + 1));
 	for (i = 0, node_ptr = node_record_table_ptr;
 	     i <= node_record_count; i++, node_ptr++) {
+		old_state[i] = node_ptr->node_state;
 		node_ptr->node_state &= (~flags);
 	}
 
@@ -5666,6 +5675,17 @@ extern int set_node_maint_mode(bool reset_all)
 	}
 	list_iterator_destroy(iter);
 
+	/*
+	 * The flags of every node were cleared and set again above, so only
+	 * note a change for nodes whose state actually differs.
+	 */
+	for (i = 0, node_ptr = node_record_table_ptr;
+	     i < node_record_count; i++, node_ptr++) {
+		if (node_ptr->node_state != old_state[i])
+			set_node_last_update(node_ptr, now);
+	}
+	xfree(old_state);
+
 	return res_start_cnt;
 }
 
@@ -381,6 +381,14 @@ struct part_record {
 	slurmdb_qos_rec_t *qos_ptr; /* pointer to the quality of
 				     * service record attached to this
 				     * partition confirm the value before use */
+	uint32_t sched_fail_cnt; /* main scheduler passes which stopped
+				  * scheduling this partition (DON'T PACK) */
+	uint32_t sched_start_cnt; /* jobs started by main scheduler in this
+				   * partition (DON'T PACK) */
+	uint32_t sched_test_cnt; /* main scheduler select_nodes() calls for
+				  * jobs in this partition (DON'T PACK) */
+	uint64_t sched_test_time; /* usec spent in those select_nodes()
+				   * calls (DON'T PACK) */
 	uint16_t state_up;	/* See PARTITION_* states in slurm.h */
 	uint32_t total_nodes;	/* total number of nodes in the partition */
 	uint32_t total_cpus;	/* total number of cpus in the partition */
@@ -713,6 +721,10 @@ struct job_record {
 	uint16_t kill_on_node_fail;	/* 1 if job should be killed on
 					 * node failure */
 	time_t last_sched_eval;		/* last time job was evaluated for scheduling */
+	time_t last_update;		/* time of last change to the job's
+					 * information, used to build job
+					 * info deltas, no need to
+					 * save/restore */
 	char *licenses;			/* licenses required by the job */
 	List license_list;		/* structure with license info */
 	acct_policy_limit_set_t limit_set; /* flags if indicate an
@@ -813,6 +825,10 @@ struct job_record {
 	uint32_t state_reason_prev_db;	/* Previous state_reason that isn't
 					 * priority or resources, only stored in
 					 * the database. */
+	char *state_rec;		/* the job's state save record as last
+					 * written to the job state journal or
+					 * snapshot, no need to save/restore */
+	uint32_t state_rec_len;		/* bytes in state_rec */
 	List step_list;			/* list of job's steps */
 	time_t suspend_time;		/* time job last suspended or resumed */
 	char *system_comment;		/* slurmctld's arbitrary comment */
@@ -1942,7 +1958,8 @@ extern int num_pending_job_array_tasks(uint32_t array_job_id);
  * IN filter_uid - pack only jobs belonging to this user if not NO_VAL
  * IN protocol_version - slurm protocol version of client
  * global: job_list - global list of job records
- * NOTE: the buffer at *buffer_ptr must be xfreed by the caller
+ * NOTE: the buffer at *buffer_ptr may be shared with other requests, it must
+ *	not be modified and must be released with free_job_info_buf()
  * NOTE: change _unpack_job_desc_msg() in common/slurm_protocol_pack.c
  *	whenever the data format changes
  */
@@ -1950,6 +1967,30 @@ extern void pack_all_jobs(char **buffer_ptr, int *buffer_size,
 			  uint16_t show_flags, uid_t uid, uint32_t filter_uid,
 			  uint16_t protocol_version);
 
+/*
+ * free_job_info_buf - release a buffer returned by pack_all_jobs()
+ * IN buffer - the buffer at *buffer_ptr set by pack_all_jobs()
+ */
+extern void free_job_info_buf(char *buffer);
+
+/*
+ * pack_delta_jobs - dump job information for jobs changed since update_time
+ *	in machine independent form (for network transmission), followed by
+ *	the IDs of jobs purged or hidden since then
+ * OUT buffer_ptr - the pointer is set to the allocated buffer.
+ * OUT buffer_size - set to size of the buffer in bytes
+ * IN update_time - time of the client's prior response
+ * IN show_flags - job filtering options
+ * IN uid - uid of user making request (for partition filtering)
+ * IN protocol_version - slurm protocol version of client
+ * RET SLURM_SUCCESS or SLURM_ERROR if no delta can be built, in which case
+ *	pack_all_jobs() must be used
+ * NOTE: the buffer at *buffer_ptr must be xfreed by the caller
+ */
+extern int pack_delta_jobs(char **buffer_ptr, int *buffer_size,
+			   time_t update_time, uint16_t show_flags, uid_t uid,
+			   uint16_t protocol_version);
+
 /*
  * pack_spec_jobs - dump job information for specified jobs in
  *	machine independent form (for network transmission)
@@ -1985,6 +2026,24 @@ extern void pack_all_node (char **buffer_ptr, int *buffer_size,
 			   uint16_t show_flags, uid_t uid,
 			   uint16_t protocol_version);
 
+/*
+ * pack_delta_node - dump configuration and node information for nodes
+ *	changed since update_time in machine independent form
+ * OUT buffer_ptr - pointer to the stored data
+ * OUT buffer_size - set to size of the buffer in bytes
+ * IN update_time - time of the client's prior response
+ * IN show_flags - node filtering options
+ * IN uid - uid of user making request (for partition filtering)
+ * IN protocol_version - slurm protocol version of client
+ * RET SLURM_SUCCESS or SLURM_ERROR if no delta can be built, in which case
+ *	pack_all_node() must be used
+ * NOTE: the caller must xfree the buffer at *buffer_ptr
+ * NOTE: READ lock_slurmctld config and partition, WRITE node before entry
+ */
+extern int pack_delta_node(char **buffer_ptr, int *buffer_size,
+			   time_t update_time, uint16_t show_flags, uid_t uid,
+			   uint16_t protocol_version);
+
 /* Pack all scheduling statistics */
 extern void pack_all_stat(int resp, char **buffer_ptr, int *buffer_size,
 			  uint16_t protocol_version);
@@ -2273,6 +2332,15 @@ extern void server_thread_incr(void);
 /* Set a job's alias_list string */
 extern void set_job_alias_list(struct job_record *job_ptr);
 
+/*
+ * set_job_last_update - note a change to a job's information, used to
+ *	build job info deltas
+ * IN job_ptr - pointer to the job_record
+ * IN now - time of the change
+ * global: last_job_update - time of last job table update
+ */
+extern void set_job_last_update(struct job_record *job_ptr, time_t now);
+
 /*
  * set_job_prio - set a default job priority
  * IN job_ptr - pointer to the job_record
@@ -2295,6 +2363,15 @@ extern void set_node_down (char *name, char *reason);
  */
 void set_node_down_ptr (struct node_record *node_ptr, char *reason);
 
+/*
+ * set_node_last_update - note a change to a node's information, used to
+ *	build node info deltas
+ * IN node_ptr - pointer to the node_record
+ * IN now - time of the change
+ * global: last_node_update - time of last node table update
+ */
+extern void set_node_last_update(struct node_record *node_ptr, time_t now);
+
 /*
  * set_slurmctld_state_loc - create state directory as needed and "cd" to it
  */
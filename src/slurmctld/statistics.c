@@ -39,6 +39,7 @@
 #include <stdio.h>
 
 #include "src/slurmctld/agent.h"
+#include "src/slurmctld/locks.h"
 #include "src/slurmctld/slurmctld.h"
 #include "src/common/list.h"
 #include "src/common/pack.h"
@@ -47,6 +48,62 @@
 
 extern int retry_list_size(void);
 
+/* Pack the main scheduler's per partition statistics */
+static void _pack_part_sched_stats(Buf buffer)
+{
+	slurmctld_lock_t part_read_lock =
+		{ NO_LOCK, NO_LOCK, NO_LOCK, READ_LOCK, NO_LOCK };
+	struct part_record *part_ptr;
+	ListIterator part_iterator;
+	char **name;
+	uint32_t *test_cnt, *start_cnt, *fail_cnt;
+	uint64_t *test_time;
+	int i = 0, part_cnt;
+
+	lock_slurmctld(part_read_lock);
+	part_cnt = list_count(part_list);
+	name      = xmalloc(sizeof(char *) * part_cnt);
+	test_cnt  = xmalloc(sizeof(uint32_t) * part_cnt);
+	test_time = xmalloc(sizeof(uint64_t) * part_cnt);
+	start_cnt = xmalloc(sizeof(uint32_t) * part_cnt);
+	fail_cnt  = xmalloc(sizeof(uint32_t) * part_cnt);
+	part_iterator = list_iterator_create(part_list);
+	while ((part_ptr = list_next(part_iterator))) {
+		name[i]      = part_ptr->name;
+		test_cnt[i]  = part_ptr->sched_test_cnt;
+		test_time[i] = part_ptr->sched_test_time;
+		start_cnt[i] = part_ptr->sched_start_cnt;
+		fail_cnt[i]  = part_ptr->sched_fail_cnt;
+		i++;
+	}
+	list_iterator_destroy(part_iterator);
+
+	packstr_array(name, part_cnt, buffer);
+	unlock_slurmctld(part_read_lock);
+	pack32_array(test_cnt,  part_cnt, buffer);
+	pack64_array(test_time, part_cnt, buffer);
+	pack32_array(start_cnt, part_cnt, buffer);
+	pack32_array(fail_cnt,  part_cnt, buffer);
+
+	xfree(name);
+	xfree(test_cnt);
+	xfree(test_time);
+	xfree(start_cnt);
+	xfree(fail_cnt);
+}
+
+static int _reset_part_sched_stats(void *x, void *arg)
+{
+	struct part_record *part_ptr = (struct part_record *) x;
+
+	part_ptr->sched_test_cnt = 0;
+	part_ptr->sched_test_time = 0;
+	part_ptr->sched_start_cnt = 0;
+	part_ptr->sched_fail_cnt = 0;
+
+	return 0;
+}
+
 /* Pack all scheduling statistics */
 extern void pack_all_stat(int resp, char **buffer_ptr, int *buffer_size,
 			  uint16_t protocol_version)
@@ -71,7 +128,74 @@ extern void pack_all_stat(int resp, char **buffer_ptr, int *buffer_size,
 	}
 
 	buffer = init_buf(BUF_SIZE);
-	if (protocol_version >= SLURM_18_08_PROTOCOL_VERSION) {
+	if (protocol_version >= SLURM_19_05_PROTOCOL_VERSION) {
+		parts_packed = resp;
+		pack32(parts_packed, buffer);
+
+		if (resp) {
+			pack_time(now, buffer);
+			debug3("pack_all_stat: time = %u",
+			       (uint32_t) last_proc_req_start);
+			pack_time(last_proc_req_start, buffer);
+
+			debug3("pack_all_stat: server_thread_count = %u",
+			       slurmctld_config.server_thread_count);
+			pack32(slurmctld_config.server_thread_count, buffer);
+
+			agent_queue_size = retry_list_size();
+			pack32(agent_queue_size, buffer);
+			agent_count = get_agent_count();
+			pack32(agent_count, buffer);
+			pack32(slurmdbd_queue_size, buffer);
+			pack32(slurmctld_diag_stats.latency, buffer);
+
+			pack32(slurmctld_diag_stats.jobs_submitted, buffer);
+			pack32(slurmctld_diag_stats.jobs_started, buffer);
+			pack32(slurmctld_diag_stats.jobs_completed, buffer);
+			pack32(slurmctld_diag_stats.jobs_canceled, buffer);
+			pack32(slurmctld_diag_stats.jobs_failed, buffer);
+
+			pack32(slurmctld_diag_stats.jobs_pending, buffer);
+			pack32(slurmctld_diag_stats.jobs_running, buffer);
+			pack_time(slurmctld_diag_stats.job_states_ts, buffer);
+
+			pack32(slurmctld_diag_stats.schedule_cycle_max,
+			       buffer);
+			pack32(slurmctld_diag_stats.schedule_cycle_last,
+			       buffer);
+			pack32(slurmctld_diag_stats.schedule_cycle_sum,
+			       buffer);
+			pack32(slurmctld_diag_stats.schedule_cycle_counter,
+			       buffer);
+			pack32(slurmctld_diag_stats.schedule_cycle_depth,
+			       buffer);
+			pack32(slurmctld_diag_stats.schedule_queue_len, buffer);
+
+			pack32(slurmctld_diag_stats.backfilled_jobs, buffer);
+			pack32(slurmctld_diag_stats.last_backfilled_jobs,
+			       buffer);
+			pack32(slurmctld_diag_stats.bf_cycle_counter, buffer);
+			pack64(slurmctld_diag_stats.bf_cycle_sum, buffer);
+			pack32(slurmctld_diag_stats.bf_cycle_last, buffer);
+			pack32(slurmctld_diag_stats.bf_last_depth, buffer);
+			pack32(slurmctld_diag_stats.bf_last_depth_try, buffer);
+
+			pack32(slurmctld_diag_stats.bf_queue_len, buffer);
+			pack32(slurmctld_diag_stats.bf_cycle_max, buffer);
+			pack_time(slurmctld_diag_stats.bf_when_last_cycle,
+				  buffer);
+			pack32(slurmctld_diag_stats.bf_depth_sum, buffer);
+			pack32(slurmctld_diag_stats.bf_depth_try_sum, buffer);
+			pack32(slurmctld_diag_stats.bf_queue_len_sum, buffer);
+
+			pack32(slurmctld_diag_stats.bf_active, buffer);
+			pack32(slurmctld_diag_stats.backfilled_pack_jobs,
+			       buffer);
+
+			pack_lock_stats(buffer);
+			_pack_part_sched_stats(buffer);
+		}
+	} else if (protocol_version >= SLURM_18_08_PROTOCOL_VERSION) {
 		parts_packed = resp;
 		pack32(parts_packed, buffer);
 
@@ -207,6 +331,10 @@ extern void pack_all_stat(int resp, char **buffer_ptr, int *buffer_size,
  * level IN - clear backfilled_jobs count if set */
 extern void reset_stats(int level)
 {
+	/* The main scheduler updates the counters with a partition read lock */
+	slurmctld_lock_t part_write_lock =
+		{ NO_LOCK, NO_LOCK, NO_LOCK, WRITE_LOCK, NO_LOCK };
+
 	slurmctld_diag_stats.proc_req_raw = 0;
 	slurmctld_diag_stats.proc_req_threads = 0;
 	slurmctld_diag_stats.schedule_cycle_max = 0;
@@ -237,5 +365,12 @@ extern void reset_stats(int level)
 	slurmctld_diag_stats.bf_last_depth_try = 0;
 	slurmctld_diag_stats.bf_active = 0;
 
+	reset_lock_stats();
+
+	lock_slurmctld(part_write_lock);
+	if (part_list)
+		list_for_each(part_list, _reset_part_sched_stats, NULL);
+	unlock_slurmctld(part_write_lock);
+
 	last_proc_req_start = time(NULL);
 }
@@ -757,7 +757,8 @@ static int _unpack_persist_init(slurmdbd_conn_t *slurmdbd_conn,
 
 	*out_buffer = slurm_persist_make_rc_msg_flags(
 		slurmdbd_conn->conn, rc, comment,
-		slurmdbd_conf->persist_conn_rc_flags,
+		slurmdbd_conf->persist_conn_rc_flags |
+		(slurmdbd_conn->conn->flags & PERSIST_FLAG_LZ4),
 		req_msg->version);
 
 	return rc;
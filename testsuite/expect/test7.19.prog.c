@@ -0,0 +1,127 @@
+/*****************************************************************************\
+ *  test7.19.prog.c - Test of slurm_load_jobs_delta() and
+ *  slurm_load_node_delta().
+ *
+ *  Usage: test7.19.prog <job_id>
+ *  The job should be held so that nothing but this program changes it.
+ *****************************************************************************
+ *  This file is part of Slurm, a resource management program.
+ *  For details, see <https://slurm.schedmd.com/>.
+ *  Please also read the included file: DISCLAIMER.
+ *
+ *  Slurm is free software; you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation; either version 2 of the License, or (at your option)
+ *  any later version.
+ *
+ *  Slurm is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with Slurm; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+\*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "slurm/slurm.h"
+#include "slurm/slurm_errno.h"
+
+static slurm_job_info_t *_find_job(job_info_msg_t *job_msg, uint32_t job_id)
+{
+	uint32_t i;
+
+	for (i = 0; i < job_msg->record_count; i++) {
+		if (job_msg->job_array[i].job_id == job_id)
+			return &job_msg->job_array[i];
+	}
+	return NULL;
+}
+
+static int _check_comment(slurm_job_info_t *job_ptr, char *comment)
+{
+	if (!job_ptr || !job_ptr->comment || strcmp(job_ptr->comment, comment))
+		return 1;
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	job_info_msg_t *job_msg = NULL, *delta_msg = NULL;
+	node_info_msg_t *node_msg = NULL;
+	job_desc_msg_t job_desc;
+	uint16_t show_flags = SHOW_ALL | SHOW_LOCAL;
+	uint32_t job_id, node_cnt;
+	time_t update_time;
+	char comment[64];
+
+	if (argc < 2) {
+		printf("Usage: %s <job_id>\n", argv[0]);
+		exit(1);
+	}
+	job_id = atoi(argv[1]);
+	snprintf(comment, sizeof(comment), "test7.19_%u", job_id);
+
+	/* Load all jobs, then change the job */
+	if (slurm_load_jobs_delta(&job_msg, show_flags)) {
+		slurm_perror("slurm_load_jobs_delta");
+		exit(1);
+	}
+	if (!_find_job(job_msg, job_id)) {
+		printf("FAILURE: job %u not loaded\n", job_id);
+		exit(1);
+	}
+	update_time = job_msg->last_update;
+
+	slurm_init_job_desc_msg(&job_desc);
+	job_desc.job_id = job_id;
+	job_desc.comment = comment;
+	if (slurm_update_job(&job_desc)) {
+		slurm_perror("slurm_update_job");
+		exit(1);
+	}
+
+	/* The changed job must be in the next delta */
+	if (slurm_load_jobs(update_time, &delta_msg, show_flags | SHOW_DELTA)) {
+		slurm_perror("slurm_load_jobs");
+		exit(1);
+	}
+	printf("job delta:%u records:%u\n", delta_msg->delta,
+	       delta_msg->record_count);
+	if (!delta_msg->delta)
+		printf("FAILURE: no job delta built\n");
+	if (_check_comment(_find_job(delta_msg, job_id), comment))
+		printf("FAILURE: job %u change not in delta\n", job_id);
+	slurm_free_job_info_msg(delta_msg);
+
+	/* And be merged into the local copy */
+	if (slurm_load_jobs_delta(&job_msg, show_flags)) {
+		slurm_perror("slurm_load_jobs_delta");
+		exit(1);
+	}
+	if (_check_comment(_find_job(job_msg, job_id), comment))
+		printf("FAILURE: job %u change not merged\n", job_id);
+	slurm_free_job_info_msg(job_msg);
+
+	/* Merging a node delta must keep every node record */
+	if (slurm_load_node_delta(&node_msg, SHOW_ALL)) {
+		slurm_perror("slurm_load_node_delta");
+		exit(1);
+	}
+	node_cnt = node_msg->record_count;
+	if (slurm_load_node_delta(&node_msg, SHOW_ALL)) {
+		slurm_perror("slurm_load_node_delta");
+		exit(1);
+	}
+	printf("node records:%u\n", node_msg->record_count);
+	if (node_msg->record_count != node_cnt) {
+		printf("FAILURE: node count changed from %u to %u\n",
+		       node_cnt, node_msg->record_count);
+	}
+	slurm_free_node_info_msg(node_msg);
+
+	exit(0);
+}
@@ -20,6 +20,38 @@
 		pass( _msg );		\
 } while (0)
 
+/* Time _iters runs of _op and report it, timings are not checked */
+#define BENCH(_name, _bits, _iters, _op) do {				\
+	struct timeval tv1, tv2;					\
+	long usec;							\
+	int _j;								\
+	gettimeofday(&tv1, NULL);					\
+	for (_j = 0; _j < (_iters); _j++)				\
+		_op;							\
+	gettimeofday(&tv2, NULL);					\
+	usec = (tv2.tv_sec - tv1.tv_sec) * 1000000 +			\
+	       (tv2.tv_usec - tv1.tv_usec);				\
+	note("%-18s %7d bits %8d iterations %8ld usec",		\
+	     (_name), (_bits), (_iters), usec);				\
+} while (0)
+
+
+/* Reference version of bit_nffc()/bit_nffs() using bit_test() */
+static bitoff_t
+_ref_run(bitstr_t *b, bitoff_t start, bitoff_t end, int n, int set)
+{
+	bitoff_t bit;
+	int cnt = 0;
+
+	for (bit = start; bit < end; bit++) {
+		if (bit_test(b, bit) != set) {
+			cnt = 0;
+		} else if (++cnt >= n) {
+			return bit - (cnt - 1);
+		}
+	}
+	return -1;
+}
 
 int
 main(int argc, char *argv[])
@@ -207,6 +239,184 @@ main(int argc, char *argv[])
 		TEST(bit_equal(bs, bs2), "bitstring");
 	}
 
+	note("Testing word operations against bit_test");
+	{
+		int sizes[] = { 1, 63, 64, 65, 255, 256, 257, 1000, 4099 };
+		int i, j, k, sz;
+
+		srand(1);
+		for (i = 0; i < (sizeof(sizes) / sizeof(int)); i++) {
+			bitstr_t *bs1, *bs2, *bs3;
+			int and_cnt = 0, set_cnt = 0, ffc = -1, ffs = -1;
+			int super = 1, range_cnt = 0, ok = 1;
+
+			sz = sizes[i];
+			bs1 = bit_alloc(sz);
+			bs2 = bit_alloc(sz);
+			for (j = 0; j < sz; j++) {
+				if ((rand() % 8) == 0)
+					bit_set(bs1, j);
+				if ((rand() % 2) == 0)
+					bit_set(bs2, j);
+			}
+			for (j = 0; j < sz; j++) {
+				if (bit_test(bs1, j)) {
+					set_cnt++;
+					if (ffs == -1)
+						ffs = j;
+					if (j >= (sz / 3))
+						range_cnt++;
+					if (bit_test(bs2, j))
+						and_cnt++;
+					else
+						super = 0;
+				} else if (ffc == -1) {
+					ffc = j;
+				}
+			}
+			TEST(bit_set_count(bs1) == set_cnt, "set_count");
+			TEST(bit_set_count_range(bs1, sz / 3, sz) == range_cnt,
+			     "set_count_range");
+			TEST(bit_overlap(bs1, bs2) == and_cnt, "overlap");
+			TEST(bit_overlap_any(bs1, bs2) == (and_cnt > 0),
+			     "overlap_any");
+			TEST(bit_super_set(bs1, bs2) == super, "super_set");
+			TEST(bit_ffs(bs1) == ffs, "ffs");
+			TEST(bit_ffc(bs1) == ffc, "ffc");
+
+			bs3 = bit_copy(bs1);
+			TEST(bit_equal(bs1, bs3), "equal");
+			TEST(bit_and_set_count(bs3, bs2) == and_cnt,
+			     "and_set_count");
+			/* (bs1 | ~bs2) & ~bs1 == ~(bs1 | bs2) */
+			bit_copybits(bs3, bs1);
+			bit_or_not(bs3, bs2);
+			bit_and_not(bs3, bs1);
+			bit_or(bs1, bs2);
+			bit_not(bs1);
+			for (k = 0; k < sz; k++) {
+				if (bit_test(bs1, k) != bit_test(bs3, k))
+					ok = 0;
+			}
+			TEST(ok, "not/or/or_not/and_not");
+
+			bit_nset(bs1, 0, sz - 1);
+			TEST(bit_ffc(bs1) == -1, "ffc full");
+			bit_clear(bs1, sz - 1);
+			TEST(bit_ffc(bs1) == (sz - 1), "ffc last");
+			bit_not(bs1);
+			TEST(bit_ffs(bs1) == (sz - 1), "ffs last");
+
+			bit_free(bs1);
+			bit_free(bs2);
+			bit_free(bs3);
+		}
+	}
+
+	note("Testing run searches against bit_test");
+	{
+		int sizes[] = { 63, 64, 65, 200, 1000, 4099 };
+		int i, j, n, sz, fls, run, max_run;
+		int ok_nffc, ok_nffs, ok_noc;
+
+		srand(2);
+		for (i = 0; i < (sizeof(sizes) / sizeof(int)); i++) {
+			bitstr_t *bs;
+
+			sz = sizes[i];
+			bs = bit_alloc(sz);
+			/* long runs of set and clear bits */
+			for (j = 0; j < sz; j++) {
+				if (((j / 70) % 2) ? ((rand() % 50) != 0) :
+				    ((rand() % 20) == 0))
+					bit_set(bs, j);
+			}
+			fls = -1;
+			run = max_run = 0;
+			for (j = 0; j < sz; j++) {
+				if (bit_test(bs, j)) {
+					fls = j;
+					if (++run > max_run)
+						max_run = run;
+				} else {
+					run = 0;
+				}
+			}
+			TEST(bit_fls(bs) == fls, "fls");
+			TEST(bit_nset_max_count(bs) == max_run,
+			     "nset_max_count");
+
+			ok_nffc = ok_nffs = ok_noc = 1;
+			for (n = 1; n < sz; n += 7) {
+				int seed = (n * 13) % sz, expect;
+
+				if (bit_nffc(bs, n) != _ref_run(bs, 0, sz, n, 0))
+					ok_nffc = 0;
+				if (bit_nffs(bs, n) !=
+				    _ref_run(bs, 0, sz - n + 1, n, 1))
+					ok_nffs = 0;
+				if ((seed + n) >= sz)
+					expect = _ref_run(bs, 0, sz, n, 0);
+				else if ((expect = _ref_run(bs, seed, sz, n, 0))
+					 == -1)
+					expect = _ref_run(bs, 0, seed + n - 1,
+							  n, 0);
+				if (bit_noc(bs, n, seed) != expect)
+					ok_noc = 0;
+			}
+			TEST(ok_nffc, "nffc");
+			TEST(ok_nffs, "nffs");
+			TEST(ok_noc, "noc");
+
+			bit_not(bs);	/* sets the unused bits past the end */
+			bit_nclear(bs, 0, sz - 1);
+			TEST(bit_fls(bs) == -1, "fls past end");
+			bit_free(bs);
+		}
+	}
+
+	note("Benchmarking word operations");
+	{
+		int sizes[] = { 512, 16384, 262144 };
+		int i, iters, sz, cnt = 0;
+
+		for (i = 0; i < (sizeof(sizes) / sizeof(int)); i++) {
+			bitstr_t *bs1, *bs2;
+
+			sz = sizes[i];
+			bs1 = bit_alloc(sz);
+			bs2 = bit_alloc(sz);
+			iters = (64 * 1024 * 1024) / sz;
+			bit_nset(bs1, 0, sz - 1);
+			bit_set(bs2, sz - 1);
+
+			BENCH("bit_and", sz, iters, bit_and(bs1, bs1));
+			BENCH("bit_or", sz, iters, bit_or(bs1, bs2));
+			BENCH("bit_set_count", sz, iters,
+			      cnt += bit_set_count(bs1));
+			BENCH("bit_overlap", sz, iters,
+			      cnt += bit_overlap(bs1, bs2));
+			BENCH("bit_overlap_any", sz, iters,
+			      cnt += bit_overlap_any(bs2, bs1));
+			BENCH("bit_and_set_count", sz, iters,
+			      cnt += bit_and_set_count(bs1, bs1));
+			BENCH("bit_super_set", sz, iters,
+			      cnt += bit_super_set(bs2, bs1));
+			BENCH("bit_ffs", sz, iters, cnt += bit_ffs(bs2));
+			BENCH("bit_ffc", sz, iters, cnt += bit_ffc(bs1));
+			BENCH("bit_fls", sz, iters, cnt += bit_fls(bs1));
+			BENCH("bit_nffs", sz, iters,
+			      cnt += bit_nffs(bs1, sz / 2));
+			BENCH("bit_nffc", sz, iters,
+			      cnt += bit_nffc(bs2, sz / 2));
+
+			bit_free(bs1);
+			bit_free(bs2);
+		}
+		/* Timings are only reported, keep the results live */
+		note("benchmark checksum %d", cnt);
+	}
+
 	totals();
 	return failed;
 }
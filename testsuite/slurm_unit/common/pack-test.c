@@ -19,7 +19,7 @@
 
 int main (int argc, char *argv[])
 {
-	Buf buffer;
+	Buf buffer, zbuf, zmsg;
 	uint16_t test16 = 1234, out16;
 	uint32_t test32 = 5678, out32, byte_cnt;
 	char testbytes[] = "TEST BYTES", *outbytes;
@@ -83,6 +83,49 @@ int main (int argc, char *argv[])
 	xfree(outstring);
 
 	free_buf(buffer);
+
+	/* Buffers grow as needed, and may be reserved ahead of packing */
+	buffer = init_buf(16);
+	for (out32 = 0; out32 < 100000; out32++)
+		pack32(out32, buffer);
+	TEST(get_buf_offset(buffer) != (100000 * sizeof(uint32_t)),
+	     "grow while packing");
+	TEST(try_grow_buf_remaining(buffer, 1024 * 1024) ||
+	     (remaining_buf(buffer) < 1024 * 1024), "try_grow_buf_remaining");
+	set_buf_offset(buffer, 0);
+	for (test32 = 0; test32 < 100000; test32++) {
+		if (unpack32(&out32, buffer) || (out32 != test32))
+			break;
+	}
+	TEST(test32 != 100000, "unpack after grow");
+	free_buf(buffer);
+
+	buffer = init_buf(0);
+	for (test32 = 0; test32 < 10000; test32++)
+		packstr(teststring, buffer);
+	zbuf = lz4_compress_buf(get_buf_data(buffer), get_buf_offset(buffer));
+	if (!lz4_buf_enabled()) {
+		TEST(zbuf != NULL, "lz4_compress_buf without lz4");
+	} else if (!zbuf) {
+		fail("lz4_compress_buf");
+	} else {
+		pass("lz4_compress_buf");
+		data = xmalloc(sizeof(uint32_t) + get_buf_offset(zbuf));
+		memcpy(data + sizeof(uint32_t), get_buf_data(zbuf),
+		       get_buf_offset(zbuf));
+		zmsg = create_buf(data, sizeof(uint32_t) + get_buf_offset(zbuf));
+		set_buf_offset(zmsg, sizeof(uint32_t));
+		TEST(lz4_uncompress_buf(zmsg) ||
+		     (get_buf_offset(zmsg) != sizeof(uint32_t)) ||
+		     (remaining_buf(zmsg) != get_buf_offset(buffer)) ||
+		     memcmp(get_buf_data(zmsg) + sizeof(uint32_t),
+			    get_buf_data(buffer), get_buf_offset(buffer)),
+		     "lz4_uncompress_buf");
+		free_buf(zmsg);
+		free_buf(zbuf);
+	}
+	free_buf(buffer);
+
 	totals();
 	return failed;
 